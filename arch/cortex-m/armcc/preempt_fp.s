@@ -5,8 +5,12 @@
 
                         AREA        |.text|, CODE, READONLY
 
+;浮点上下文控制寄存器，BIT0(LSPACT)指示Lazy Stacking的保存尚未执行
+FPCCR                   EQU         0xE000EF34
+
 PendSV_Handler          PROC
-                        IMPORT      kevent_schedule
+                        IMPORT      kevent_preempt_check
+                        IMPORT      kevent_preempt_schedule
                         EXPORT      PendSV_Handler
 
                         ;PendSV异常处理程序通过插入伪造的异常返回上下文实现抢占被中断的线程的CPU
@@ -22,6 +26,18 @@ PendSV_Handler          PROC
                         ;BIT24: 当这个位被设置时，异常返回后进入Thumb模式，否则返回到ARM模式
                         ;BIT9: 当这个位被设置时，表示栈已开启8Byte对齐，并指示在弹出线程上下文后SP+4
 
+                        ;快速路径：检查调度器的就绪状态，没有可以抢占的事件时直接返回，
+                        ;无需插入伪造的现场，也不会触发Lazy Stacking
+                        ;同时压入R0以保持栈的8Byte对齐
+                        PUSH        {R0, LR}
+                        BL          kevent_preempt_check
+                        CMP         R0, #0
+                        BNE         PREEMPT_REQUIRED
+                        POP         {R0, PC}
+
+PREEMPT_REQUIRED
+                        POP         {R0, LR}
+
                         ;备份LR的状态
                         MOV         R0, LR
 
@@ -29,8 +45,11 @@ PendSV_Handler          PROC
                         LSLS        R1, R0, #27
                         BMI         THREAD_USE_FP_ENDIF
 
-                        ;当线程使用了浮点功能时，我们需要执行一条浮点指令，触发Lazy Stacking做浮点上下文保存
-                        VCMP.F32    S0, #0.0
+                        ;当线程使用了浮点功能时，异常入口已为浮点上下文预留了空间并置位了FPCCR.LSPACT，
+                        ;我们不主动触发Lazy Stacking，伪造的异常返回不会清除LSPACT，
+                        ;抢占期间第一条浮点指令(包括嵌套的中断与抢占)才会将S0-S15与FPSCR保存至预留的空间，
+                        ;不使用浮点的事件不会产生任何浮点上下文保存的开销
+                        ;S16-S31由回调函数按照调用约定自行保存
 
                         ;我们需要插入伪造的无浮点上下文的异常返回现场，因此我们设置LR的BIT4和清除CONTROL的BIT2(FPCA)
                         ORRS        LR, #0x10
@@ -80,8 +99,8 @@ PENDSV_EXC_RETURN_HANDLER
                         ;保存异常时的LR的状态
                         PUSH        {R0}
 
-                        ;调用调度程序
-                        BL          k_schedule
+                        ;调用调度程序，返回时中断处于关闭状态，恢复期间提交的事件在恢复完成后再次进入PendSV
+                        BL          kevent_preempt_schedule
 
                         ;当抢占程序执行结束之后，我们需要恢复抢占前的上下文
                         ;我们先对浮点上下文做恢复，此后再恢复非浮点部分的上下文
@@ -97,6 +116,20 @@ PENDSV_EXC_RETURN_HANDLER
                         LSLS        R1, R0, #27
                         BMI         THREAD_RESTORE_USE_FP_ENDIF
 
+                        ;检查FPCCR.LSPACT，若仍置位，则抢占期间没有执行过浮点指令，浮点寄存器仍为线程的值
+                        LDR         R2, =FPCCR
+                        LDR         R1, [R2]
+                        LSLS        R1, R1, #31
+                        BEQ         THREAD_FP_CONTEXT_SAVED
+
+                        ;清除LSPACT，撤销对预留空间的延迟保存，并跳过预留的浮点上下文空间
+                        LDR         R1, [R2]
+                        BICS        R1, #1
+                        STR         R1, [R2]
+                        ADDS        R3, #72
+                        B           THREAD_RESTORE_USE_FP_ENDIF
+
+THREAD_FP_CONTEXT_SAVED
                         ;恢复浮点上下文，并将空位弹出
                         VLDMIA.F32  R3!, {S0-S15}
                         LDMIA       R3!, {R1}
@@ -141,6 +174,9 @@ THREAD_RESTORE_USE_FP_ENDIF
                         POP         {R0-R3}
                         MOV         SP, R4
 
+                        ;打开中断，PendSV仅在被中断的线程未关闭中断时才会进入，因此总是打开中断
+                        CPSIE       I
+
                         ;返回抢占线程
                         POP         {R4, PC}
 
@@ -6,7 +6,8 @@
                         AREA    |.text|, CODE, READONLY
 
 PendSV_Handler          PROC
-                        IMPORT      kevent_schedule
+                        IMPORT      kevent_preempt_check
+                        IMPORT      kevent_preempt_schedule
                         EXPORT		PendSV_Handler
 
                         ;PendSV异常处理程序通过插入伪造的异常返回上下文实现抢占被中断的线程的CPU
@@ -21,6 +22,18 @@ PendSV_Handler          PROC
                         ;BIT24: 当这个位被设置时，异常返回后进入Thumb模式，否则返回到ARM模式
                         ;BIT9: 当这个位被设置时，表示栈已开启8Byte对齐，并指示在弹出线程上下文后SP+4
 
+                        ;快速路径：检查调度器的就绪状态，没有可以抢占的事件时直接返回，无需插入伪造的现场
+                        ;同时压入R0以保持栈的8Byte对齐
+                        PUSH        {R0, LR}
+                        BL          kevent_preempt_check
+                        CMP         R0, #0
+                        BNE         PREEMPT_REQUIRED
+                        POP         {R0, PC}
+
+PREEMPT_REQUIRED
+                        POP         {R0, R1}
+                        MOV         LR, R1
+
                         ;备份LR的状态
                         MOV         R0, LR
 
@@ -61,11 +74,13 @@ INSERT_FAKE_EXC_RETURN_CONTEXT_SPACE_ENDIF
                         BX          LR
                         NOP
 PENDSV_EXC_RETURN_HANDLER
-                        ;调用调度程序
-                        BL          kevent_schedule
+                        ;调用调度程序，返回时中断处于关闭状态
+                        BL          kevent_preempt_schedule
 
                         ;当抢占程序执行结束之后，我们需要恢复抢占前的上下文
                         ;我们还需要检查xPSR的BIT9，确定恢复之后的栈顶位置
+                        ;恢复期间中断保持关闭，期间提交的事件在恢复完成后再次进入PendSV，
+                        ;而不是在未恢复完成的伪造现场之上嵌套新的现场
 
                         ;我们将R3指向线程恢复后栈顶的前两个字的位置，用于存放R4与PC
                         ADD         R3, SP, #24
@@ -106,6 +121,9 @@ PENDSV_EXC_RETURN_HANDLER
                         POP         {R0-R3}
                         MOV         SP, R4
 
+                        ;打开中断，PendSV仅在被中断的线程未关闭中断时才会进入，因此总是打开中断
+                        CPSIE       I
+
                         ;返回被抢占的线程
                         POP         {R4, PC}
 
@@ -7,6 +7,9 @@
                         .text
                         .fpu        vfpv2
 
+                        /* 浮点上下文控制寄存器，BIT0(LSPACT)指示Lazy Stacking的保存尚未执行 */
+                        .equ        FPCCR, 0xE000EF34
+
                         .global     PendSV_Handler
                         .type       PendSV_Handler, %function
 PendSV_Handler:
@@ -26,6 +29,19 @@ PendSV_Handler:
                          * BIT9: 当这个位被设置时，表示栈已开启8Byte对齐，并指示在弹出线程上下文后SP+4
                          */
 
+                        /* 快速路径：检查调度器的就绪状态，没有可以抢占的事件时直接返回，
+                         * 无需插入伪造的现场，也不会触发Lazy Stacking
+                         * 同时压入R0以保持栈的8Byte对齐
+                         */
+                        PUSH        {R0, LR}
+                        BL          kevent_preempt_check
+                        CMP         R0, #0
+                        BNE         preempt_required
+                        POP         {R0, PC}
+
+preempt_required:
+                        POP         {R0, LR}
+
                         /* 备份LR的状态 */
                         MOV         R0, LR
 
@@ -33,8 +49,12 @@ PendSV_Handler:
                         LSLS        R1, R0, #27
                         BMI         thread_use_fp_endif
 
-                        /* 当线程使用了浮点功能时，我们需要执行一条浮点指令，触发Lazy Stacking做浮点上下文保存 */
-                        VCMP.F32    S0, #0.0
+                        /* 当线程使用了浮点功能时，异常入口已为浮点上下文预留了空间并置位了FPCCR.LSPACT，
+                         * 我们不主动触发Lazy Stacking，伪造的异常返回不会清除LSPACT，
+                         * 抢占期间第一条浮点指令(包括嵌套的中断与抢占)才会将S0-S15与FPSCR保存至预留的空间，
+                         * 不使用浮点的事件不会产生任何浮点上下文保存的开销
+                         * S16-S31由回调函数按照调用约定自行保存
+                         */
 
                         /* 我们需要插入伪造的无浮点上下文的异常返回现场，因此我们设置LR的BIT4和清除CONTROL的BIT2(FPCA) */
                         ORRS        LR, #0x10
@@ -85,8 +105,8 @@ pendsv_exc_return_handler:
                         /* 保存异常时的LR的状态 */
                         PUSH        {R0}
 
-                        /* 调用调度程序 */
-                        BL          k_schedule
+                        /* 调用调度程序，返回时中断处于关闭状态，恢复期间提交的事件在恢复完成后再次进入PendSV */
+                        BL          kevent_preempt_schedule
 
                         /* 当抢占程序执行结束之后，我们需要恢复抢占前的上下文
                          * 我们先对浮点上下文做恢复，此后再恢复非浮点部分的上下文
@@ -104,6 +124,20 @@ pendsv_exc_return_handler:
                         LSLS        R1, R0, #27
                         BMI         thread_restore_use_fp_endif
 
+                        /* 检查FPCCR.LSPACT，若仍置位，则抢占期间没有执行过浮点指令，浮点寄存器仍为线程的值 */
+                        LDR         R2, =FPCCR
+                        LDR         R1, [R2]
+                        LSLS        R1, R1, #31
+                        BEQ         thread_fp_context_saved
+
+                        /* 清除LSPACT，撤销对预留空间的延迟保存，并跳过预留的浮点上下文空间 */
+                        LDR         R1, [R2]
+                        BICS        R1, #1
+                        STR         R1, [R2]
+                        ADDS        R3, #72
+                        B           thread_restore_use_fp_endif
+
+thread_fp_context_saved:
                         /* 恢复浮点上下文，并将空位弹出 */
                         VLDMIA.F32  R3!, {S0-S15}
                         LDMIA       R3!, {R1}
@@ -149,5 +183,8 @@ thread_restore_use_fp_endif:
                         POP         {R0-R3}
                         MOV         SP, R4
 
+                        /* 打开中断，PendSV仅在被中断的线程未关闭中断时才会进入，因此总是打开中断 */
+                        CPSIE       I
+
                         /* 返回抢占线程 */
                         POP         {R4, PC}
@@ -23,6 +23,19 @@ PendSV_Handler:
                         *  BIT9: 当这个位被设置时，表示栈已开启8Byte对齐，并指示在弹出线程上下文后SP+4
                         */
 
+                        /* 快速路径：检查调度器的就绪状态，没有可以抢占的事件时直接返回，无需插入伪造的现场
+                         * 同时压入R0以保持栈的8Byte对齐
+                         */
+                        PUSH        {R0, LR}
+                        BL          kevent_preempt_check
+                        CMP         R0, #0
+                        BNE         preempt_required
+                        POP         {R0, PC}
+
+preempt_required:
+                        POP         {R0, R1}
+                        MOV         LR, R1
+
                         /* 备份LR的状态 */
                         MOV         R0, LR
 
@@ -64,11 +77,13 @@ insert_fake_exc_return_context_space_endif:
                         NOP
 
 pendsv_exc_return_handler:
-                        /* 调用调度程序 */
-                        BL          k_schedule
+                        /* 调用调度程序，返回时中断处于关闭状态 */
+                        BL          kevent_preempt_schedule
 
                        /* 当抢占程序执行结束之后，我们需要恢复抢占前的上下文
                         * 我们还需要检查xPSR的BIT9，确定恢复之后的栈顶位置
+                        * 恢复期间中断保持关闭，期间提交的事件在恢复完成后再次进入PendSV，
+                        * 而不是在未恢复完成的伪造现场之上嵌套新的现场
                         */
 
                         /* 我们将R3指向线程恢复后栈顶的前两个字的位置，用于存放R4与PC */
@@ -112,5 +127,8 @@ pendsv_exc_return_handler:
                         POP         {R0-R3}
                         MOV         SP, R4
 
+                        /* 打开中断，PendSV仅在被中断的线程未关闭中断时才会进入，因此总是打开中断 */
+                        CPSIE       I
+
                         /* 返回被抢占的线程 */
                         POP         {R4, PC}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+                        /* RV32机器模式的陷阱入口，以直接模式写入mtvec
+                         * 机器软件中断(MSI)用于事件抢占，与Cortex-M的PendSV相同；
+                         * 机器定时器中断(MTI)与外部中断(MEI)分别调用MTimer_Handler与MExternal_Handler；
+                         * 异常调用Exception_Handler(mcause, mepc, mtval)
+                         *
+                         * 陷阱发生时硬件关闭mstatus.MIE，并将陷阱前的状态记录到mstatus.MPIE、mepc中，
+                         * 嵌套的陷阱会覆盖它们，因此与调用者保存寄存器一同压栈
+                         *
+                         * 不保存浮点寄存器，适用于无F/D扩展或中断中不使用浮点的系统
+                         *
+                         * CLINT的基地址默认为0x02000000，可由-Wa,--defsym,RISCV_CLINT_BASE=<addr>修改，
+                         * 需要与C代码中的RISCV_CLINT_BASE保持一致
+                         */
+
+                        .ifndef     RISCV_CLINT_BASE
+                        .set        RISCV_CLINT_BASE, 0x02000000
+                        .endif
+
+                        /* 栈帧：ra，t0-t6，a0-a7，mepc，mstatus，按16Byte对齐 */
+                        .set        FRAME_SIZE, 80
+                        .set        FRAME_MEPC, 64
+                        .set        FRAME_MSTATUS, 68
+
+                        /* mcause的中断编号 */
+                        .set        IRQ_M_SOFT, 3
+                        .set        IRQ_M_TIMER, 7
+                        .set        IRQ_M_EXT, 11
+
+                        .text
+
+                        .global     riscv_trap_entry
+                        .type       riscv_trap_entry, %function
+                        .align      2
+riscv_trap_entry:
+                        addi        sp, sp, -FRAME_SIZE
+                        sw          ra, 0(sp)
+                        sw          t0, 4(sp)
+                        sw          t1, 8(sp)
+                        sw          t2, 12(sp)
+                        sw          t3, 16(sp)
+                        sw          t4, 20(sp)
+                        sw          t5, 24(sp)
+                        sw          t6, 28(sp)
+                        sw          a0, 32(sp)
+                        sw          a1, 36(sp)
+                        sw          a2, 40(sp)
+                        sw          a3, 44(sp)
+                        sw          a4, 48(sp)
+                        sw          a5, 52(sp)
+                        sw          a6, 56(sp)
+                        sw          a7, 60(sp)
+                        csrr        t0, mepc
+                        sw          t0, FRAME_MEPC(sp)
+                        csrr        t0, mstatus
+                        sw          t0, FRAME_MSTATUS(sp)
+
+                        /* mcause的最高位为0时是异常 */
+                        csrr        a0, mcause
+                        bgez        a0, trap_exception
+
+                        /* 清除中断标识位得到中断编号 */
+                        slli        t0, a0, 1
+                        srli        t0, t0, 1
+
+                        li          t1, IRQ_M_SOFT
+                        beq         t0, t1, trap_msi
+
+                        li          t1, IRQ_M_TIMER
+                        beq         t0, t1, trap_mti
+
+                        li          t1, IRQ_M_EXT
+                        bne         t0, t1, trap_return
+
+                        call        MExternal_Handler
+                        j           trap_return
+
+trap_mti:
+                        call        MTimer_Handler
+                        j           trap_return
+
+trap_exception:
+                        csrr        a1, mepc
+                        csrr        a2, mtval
+                        call        Exception_Handler
+                        j           trap_return
+
+trap_msi:
+                        /* 清除当前hart的软件中断挂起，此后提交的事件将重新挂起 */
+                        csrr        t0, mhartid
+                        slli        t0, t0, 2
+                        li          t1, RISCV_CLINT_BASE
+                        add         t1, t1, t0
+                        sw          zero, 0(t1)
+
+                        /* 快速路径：没有可以抢占的事件时直接返回 */
+                        call        kevent_preempt_check
+                        beqz        a0, trap_return
+
+                       /* 打开中断后调用调度程序，更高优先级的事件再次挂起软件中断，
+                        * 在当前的现场之上嵌套抢占，与PendSV的抢占方式相同
+                        * 调度程序返回时中断处于关闭状态，恢复期间提交的事件在mret之后再次进入
+                        */
+                        csrsi       mstatus, 8
+                        call        kevent_preempt_schedule
+
+trap_return:
+                        /* 恢复mepc与mstatus，mret以mstatus.MPIE恢复中断状态 */
+                        lw          t0, FRAME_MEPC(sp)
+                        csrw        mepc, t0
+                        lw          t0, FRAME_MSTATUS(sp)
+                        csrw        mstatus, t0
+
+                        lw          ra, 0(sp)
+                        lw          t0, 4(sp)
+                        lw          t1, 8(sp)
+                        lw          t2, 12(sp)
+                        lw          t3, 16(sp)
+                        lw          t4, 20(sp)
+                        lw          t5, 24(sp)
+                        lw          t6, 28(sp)
+                        lw          a0, 32(sp)
+                        lw          a1, 36(sp)
+                        lw          a2, 40(sp)
+                        lw          a3, 44(sp)
+                        lw          a4, 48(sp)
+                        lw          a5, 52(sp)
+                        lw          a6, 56(sp)
+                        lw          a7, 60(sp)
+                        addi        sp, sp, FRAME_SIZE
+                        mret
+
+                        .size       riscv_trap_entry, . - riscv_trap_entry
+
+                        /* 未定义的处理程序，停留在此处便于调试 */
+                        .weak       MTimer_Handler
+                        .weak       MExternal_Handler
+                        .weak       Exception_Handler
+                        .type       riscv_default_handler, %function
+riscv_default_handler:
+MTimer_Handler:
+MExternal_Handler:
+Exception_Handler:
+                        j           riscv_default_handler
@@ -0,0 +1,76 @@
+#include <os/kernel.h>
+#include <drivers/timer_port.h>
+#include <drivers/riscv/clint_timer.h>
+
+/* CLINT定时器寄存器，mtime为所有hart共享的64位计数器，每个hart有一个64位的mtimecmp */
+#define CLINT_MTIMECMP(hart)        ((volatile uint32_t *)(RISCV_CLINT_BASE + 0x4000 + 8 * (hart)))
+#define CLINT_MTIME                 ((volatile uint32_t *)(RISCV_CLINT_BASE + 0xBFF8))
+
+/* mie.MTIE */
+#define RISCV_MIE_MTIE              BIT(7)
+
+/* 永不到期的比较值 */
+#define CLINT_MTIMECMP_NEVER        UINT64_MAX
+
+/* 设置当前hart的比较值，mtime >= mtimecmp时产生定时器中断，比较由硬件以64位完成 */
+static void clint_mtimecmp_set(uint64_t cmp)
+{
+    volatile uint32_t *mtimecmp = CLINT_MTIMECMP(arch_hart_id_get());
+
+#if __riscv_xlen == 64
+    *(volatile uint64_t *)mtimecmp = cmp;
+#else
+    /* 先将低位设为最大值，避免在高低位分别写入期间产生错误的比较结果 */
+    mtimecmp[0] = UINT32_MAX;
+    mtimecmp[1] = (uint32_t)(cmp >> 32);
+    mtimecmp[0] = (uint32_t)cmp;
+#endif
+}
+
+void riscv_clint_timer_init(void)
+{
+    clint_mtimecmp_set(CLINT_MTIMECMP_NEVER);
+
+    __asm volatile("csrs mie, %0" : : "r" (RISCV_MIE_MTIE) : "memory");
+}
+
+ktime_tick_t drv_ktime_tick_get(void)
+{
+#if __riscv_xlen == 64
+    return (ktime_tick_t)*(volatile uint64_t *)CLINT_MTIME;
+#else
+    uint32_t hi, lo;
+
+    /* 高位在两次读取之间不变时，低位与高位是一致的 */
+    do {
+        hi = CLINT_MTIME[1];
+        lo = CLINT_MTIME[0];
+    } while (hi != CLINT_MTIME[1]);
+
+    return (ktime_tick_t)(((uint64_t)hi << 32) | lo);
+#endif
+}
+
+void drv_ktimer_set_expiry(ktime_tick_t expiry)
+{
+    int key;
+
+    key = irq_lock();
+
+    /* 无超时，否则直接以到期时间作为比较值，
+     * 已经过期的时间会立即触发中断，无需另外挂起
+     */
+    clint_mtimecmp_set(expiry == 0 ? CLINT_MTIMECMP_NEVER : (uint64_t)expiry);
+
+    irq_unlock(key);
+}
+
+/* 机器定时器中断，由arch/riscv/gcc/preempt_nofp.s的陷阱入口调用 */
+void MTimer_Handler(void)
+{
+    /* 定时器中断为电平触发，先清除比较值，再由超时检查设置下一个到期时间 */
+    clint_mtimecmp_set(CLINT_MTIMECMP_NEVER);
+
+    /* 处理超时 */
+    sys_ktimer_timeout_check(drv_ktime_tick_get());
+}
@@ -3,15 +3,22 @@
 
 #include <bases.h>
 
-#if defined(__ARMCC_VERSION)
+/* armclang(ARM Compiler 6)同样定义__ARMCC_VERSION，但使用GNU内联汇编语法，与gcc共用实现 */
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6000000)
 #include "asm_inline_armcc.h"
-#elif defined(__GNUC__)
+#elif defined(__GNUC__) || defined(__ARMCC_VERSION)
 #include "asm_inline_gcc.h"
 #endif
 
-static force_inline arch_irq_schedule_pending(void)
+static force_inline void arch_irq_schedule_pending(void)
 {
     *(volatile int *)0xE000ED04 = BIT(28);
 }
 
+/* 通过NVIC ISPR挂起外部中断 */
+static force_inline void arch_irq_set_pending(uint32_t irqn)
+{
+    ((volatile uint32_t *)0xE000E200)[irqn >> 5] = BIT(irqn & 0x1F);
+}
+
 #endif /* __ARCH_ARM_IRQ_H__ */
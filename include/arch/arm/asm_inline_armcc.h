@@ -7,7 +7,9 @@
 
 #include <bases.h>
 
-static force_inline int irq_lock(void)
+/* 仅用于armcc5，armclang使用asm_inline_gcc.h，armcc5不支持ARMv8-M，没有arch_stack_limit_set */
+
+static force_inline int arch_irq_lock(void)
 {
     int key;
 
@@ -17,7 +19,7 @@ static force_inline int irq_lock(void)
     return key;
 }
 
-static force_inline void irq_unlock(int key)
+static force_inline void arch_irq_unlock(int key)
 {
     if (key) {
         return;
@@ -26,4 +28,9 @@ static force_inline void irq_unlock(int key)
     __enable_irq();
 }
 
+static force_inline uintptr_t arch_stack_pointer_get(void)
+{
+    return __current_sp();
+}
+
 #endif /* __ARCH_ASM_INLINE_ARMCC_H__ */
@@ -7,7 +7,7 @@
 
 #include <bases.h>
 
-static force_inline int irq_lock(void)
+static force_inline int arch_irq_lock(void)
 {
     int key;
 
@@ -20,7 +20,7 @@ static force_inline int irq_lock(void)
     return key;
 }
 
-static force_inline void irq_unlock(int key)
+static force_inline void arch_irq_unlock(int key)
 {
     if (key) {
         return;
@@ -31,4 +31,33 @@ static force_inline void irq_unlock(int key)
         : : : "memory");
 }
 
+static force_inline uintptr_t arch_stack_pointer_get(void)
+{
+    uintptr_t sp;
+
+    __asm volatile("mov %0, sp" : "=r" (sp));
+
+    return sp;
+}
+
+#if defined(__ARM_ARCH_8M_MAIN__)
+/*********************************************************
+ *@简要：
+ ***设置ARMv8-M Mainline的栈限制寄存器，栈指针低于限制时产生精确的UsageFault(STKOF)，
+ ***检查由硬件完成，没有运行时开销
+ *
+ *@参数：
+ *[msp_limit]：MSP的最低地址，8字节对齐，0表示不限制
+ *[psp_limit]：PSP的最低地址，8字节对齐，0表示不限制
+ **********************************************************/
+static force_inline void arch_stack_limit_set(uint32_t msp_limit, uint32_t psp_limit)
+{
+    __asm volatile("msr msplim, %0;"
+        "msr psplim, %1"
+        :
+        : "r" (msp_limit), "r" (psp_limit)
+        : "memory");
+}
+#endif /* __ARM_ARCH_8M_MAIN__ */
+
 #endif /* __ARCH_ASM_INLINE_GCC_H__ */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __ARCH_HOST_IRQ_H__
+#define __ARCH_HOST_IRQ_H__
+
+#include <bases.h>
+
+/*********************************************************
+ *@说明：
+ ***主机(Linux等)上的单线程运行环境，用于基准测试与调试，
+ ***没有中断，临界区为空操作；
+ ***没有抢占，提交事件后需要由调用者执行kevent_schedule
+ *********************************************************/
+
+static force_inline int arch_irq_lock(void)
+{
+    return 0;
+}
+
+static force_inline void arch_irq_unlock(int key)
+{
+    (void)key;
+}
+
+static force_inline void arch_irq_schedule_pending(void)
+{
+}
+
+static force_inline void arch_irq_set_pending(uint32_t irqn)
+{
+    (void)irqn;
+}
+
+static force_inline uintptr_t arch_stack_pointer_get(void)
+{
+    return (uintptr_t)__builtin_frame_address(0);
+}
+
+#endif /* __ARCH_HOST_IRQ_H__ */
@@ -2,4 +2,31 @@
  * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
  */
 
+#ifndef __ARCH_IRQ_H__
+#define __ARCH_IRQ_H__
+
+#if defined(ARCH_HOST)
+#include "host/host_irq.h"
+#elif defined(__riscv)
+#include "riscv/riscv_irq.h"
+#else
 #include "arm/arm_irq.h"
+#endif
+
+#include <os/irq_profile.h>
+
+/*********************************************************
+ *@说明：
+ ***irq_lock关闭中断并返回键值，irq_unlock以键值恢复关闭前的中断状态，
+ ***键值的含义由arch_irq_lock决定，只能传递给irq_unlock；
+ ***开启IRQ_LOCK_PROFILE时记录临界区的时长与irq_lock的调用位置
+ *********************************************************/
+#if IRQ_LOCK_PROFILE
+#define irq_lock()          irq_lock_profile_enter(arch_irq_lock(), __FILE__, __LINE__)
+#define irq_unlock(key)     arch_irq_unlock(irq_lock_profile_exit(key))
+#else
+#define irq_lock()          arch_irq_lock()
+#define irq_unlock(key)     arch_irq_unlock(key)
+#endif /* IRQ_LOCK_PROFILE */
+
+#endif /* __ARCH_IRQ_H__ */
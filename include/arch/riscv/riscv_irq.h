@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __ARCH_RISCV_IRQ_H__
+#define __ARCH_RISCV_IRQ_H__
+
+#include <bases.h>
+
+/*********************************************************
+ *@说明：
+ ***RISC-V机器模式(M-mode)的中断接口，
+ ***临界区通过mstatus.MIE实现，
+ ***抢占通过CLINT的机器软件中断(MSI)挂起，由arch/riscv/gcc/preempt_nofp.s处理；
+ ***CLINT没有可由软件挂起的外部中断，因此不支持KEVENT_IRQ_GROUP_NUMS；
+ ***preempt_nofp.s的陷阱栈帧以sw/lw按4字节保存寄存器，只支持RV32，不能用于RV64
+ *********************************************************/
+
+#if defined(__riscv_xlen) && (__riscv_xlen != 32)
+#error "The RISC-V port supports RV32 only, the trap frame in preempt_nofp.s uses sw/lw"
+#endif
+
+/* CLINT的基地址，默认为QEMU virt与SiFive系列的地址 */
+#ifndef RISCV_CLINT_BASE
+#define RISCV_CLINT_BASE        0x02000000
+#endif
+
+/* CLINT的软件中断挂起寄存器，每个hart一个字 */
+#define RISCV_CLINT_MSIP(hart)  ((volatile uint32_t *)(RISCV_CLINT_BASE) + (hart))
+
+/* mstatus.MIE */
+#define RISCV_MSTATUS_MIE       BIT(3)
+
+/*********************************************************
+ *@简要：
+ ***关闭机器模式的中断
+ *
+ *@返回值：
+ ***关闭前的mstatus.MIE，不为0表示关闭前中断处于打开状态
+ **********************************************************/
+static force_inline int arch_irq_lock(void)
+{
+    unsigned long mstatus;
+
+    __asm volatile("csrrci %0, mstatus, %1"
+        : "=r" (mstatus)
+        : "i" (RISCV_MSTATUS_MIE)
+        : "memory");
+
+    return (int)(mstatus & RISCV_MSTATUS_MIE);
+}
+
+static force_inline void arch_irq_unlock(int key)
+{
+    if (!key) {
+        return;
+    }
+    __asm volatile("csrsi mstatus, %0"
+        :
+        : "i" (RISCV_MSTATUS_MIE)
+        : "memory");
+}
+
+static force_inline unsigned long arch_hart_id_get(void)
+{
+    unsigned long hart;
+
+    __asm volatile("csrr %0, mhartid" : "=r" (hart));
+
+    return hart;
+}
+
+/* 挂起当前hart的机器软件中断 */
+static force_inline void arch_irq_schedule_pending(void)
+{
+    *RISCV_CLINT_MSIP(arch_hart_id_get()) = 1;
+}
+
+/* CLINT上没有可由软件挂起的外部中断，KEVENT_IRQ_GROUP_NUMS必须为0 */
+static force_inline void arch_irq_set_pending(uint32_t irqn)
+{
+    (void)irqn;
+}
+
+static force_inline uintptr_t arch_stack_pointer_get(void)
+{
+    uintptr_t sp;
+
+    __asm volatile("mv %0, sp" : "=r" (sp));
+
+    return sp;
+}
+
+#endif /* __ARCH_RISCV_IRQ_H__ */
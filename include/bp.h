@@ -74,6 +74,16 @@
 /* BP结束标签 */
 #define BP_LABEL_END            BP_LABEL_N(end)
 
+/* 使用GCC/Clang的标签地址(&&label)恢复断点，断点号通过标签地址表映射为一次间接跳转，
+ * 定义为0时使用switch-goto语句块 */
+#ifndef BP_USE_COMPUTED_GOTO
+#if defined(__GNUC__) && !defined(__CC_ARM)
+#define BP_USE_COMPUTED_GOTO    1
+#else
+#define BP_USE_COMPUTED_GOTO    0
+#endif
+#endif
+
 /* BP_BEGIN的头部，switch-goto语句块 */
 #define __BP_HEADER(bp)         do {                                            \
                                     switch ((bp))                               \
@@ -86,6 +96,17 @@
                                     BP_LABEL_START:;                            \
                                 } while (0)                                     \
 
+/* BP_BEGIN的标签地址表部分，断点号超出范围时跳转到结束标签 */
+#define __BP_GOTO(bp_nums, bp)  do {                                            \
+                                    static void *const __bp_addrs[] = {         \
+                                        __BP_ADDRN(bp_nums)                     \
+                                    };                                          \
+                                    if ((unsigned int)(bp) > (unsigned int)(bp_nums)) \
+                                        goto BP_LABEL_END;                      \
+                                    goto *__bp_addrs[(bp)];                     \
+                                    BP_LABEL_START:;                            \
+                                } while (0)                                     \
+
 /* BP_BEGIN的case语句块部分 */
 #define __BP_CASE0      case 0: goto BP_LABEL_START;
 #define __BP_CASE1      __BP_CASE0 case 1: goto BP_LABEL_N(1);
@@ -344,6 +365,264 @@
 #define __BP_CASE254    __BP_CASE253 case 254: goto BP_LABEL_N(254);
 #define __BP_CASE255    __BP_CASE254 case 255: goto BP_LABEL_N(255);
 
+/* BP_BEGIN的标签地址表 */
+#define __BP_ADDR0      &&BP_LABEL_START
+#define __BP_ADDR1      __BP_ADDR0, &&BP_LABEL_N(1)
+#define __BP_ADDR2      __BP_ADDR1, &&BP_LABEL_N(2)
+#define __BP_ADDR3      __BP_ADDR2, &&BP_LABEL_N(3)
+#define __BP_ADDR4      __BP_ADDR3, &&BP_LABEL_N(4)
+#define __BP_ADDR5      __BP_ADDR4, &&BP_LABEL_N(5)
+#define __BP_ADDR6      __BP_ADDR5, &&BP_LABEL_N(6)
+#define __BP_ADDR7      __BP_ADDR6, &&BP_LABEL_N(7)
+#define __BP_ADDR8      __BP_ADDR7, &&BP_LABEL_N(8)
+#define __BP_ADDR9      __BP_ADDR8, &&BP_LABEL_N(9)
+#define __BP_ADDR10     __BP_ADDR9, &&BP_LABEL_N(10)
+#define __BP_ADDR11     __BP_ADDR10, &&BP_LABEL_N(11)
+#define __BP_ADDR12     __BP_ADDR11, &&BP_LABEL_N(12)
+#define __BP_ADDR13     __BP_ADDR12, &&BP_LABEL_N(13)
+#define __BP_ADDR14     __BP_ADDR13, &&BP_LABEL_N(14)
+#define __BP_ADDR15     __BP_ADDR14, &&BP_LABEL_N(15)
+#define __BP_ADDR16     __BP_ADDR15, &&BP_LABEL_N(16)
+#define __BP_ADDR17     __BP_ADDR16, &&BP_LABEL_N(17)
+#define __BP_ADDR18     __BP_ADDR17, &&BP_LABEL_N(18)
+#define __BP_ADDR19     __BP_ADDR18, &&BP_LABEL_N(19)
+#define __BP_ADDR20     __BP_ADDR19, &&BP_LABEL_N(20)
+#define __BP_ADDR21     __BP_ADDR20, &&BP_LABEL_N(21)
+#define __BP_ADDR22     __BP_ADDR21, &&BP_LABEL_N(22)
+#define __BP_ADDR23     __BP_ADDR22, &&BP_LABEL_N(23)
+#define __BP_ADDR24     __BP_ADDR23, &&BP_LABEL_N(24)
+#define __BP_ADDR25     __BP_ADDR24, &&BP_LABEL_N(25)
+#define __BP_ADDR26     __BP_ADDR25, &&BP_LABEL_N(26)
+#define __BP_ADDR27     __BP_ADDR26, &&BP_LABEL_N(27)
+#define __BP_ADDR28     __BP_ADDR27, &&BP_LABEL_N(28)
+#define __BP_ADDR29     __BP_ADDR28, &&BP_LABEL_N(29)
+#define __BP_ADDR30     __BP_ADDR29, &&BP_LABEL_N(30)
+#define __BP_ADDR31     __BP_ADDR30, &&BP_LABEL_N(31)
+#define __BP_ADDR32     __BP_ADDR31, &&BP_LABEL_N(32)
+#define __BP_ADDR33     __BP_ADDR32, &&BP_LABEL_N(33)
+#define __BP_ADDR34     __BP_ADDR33, &&BP_LABEL_N(34)
+#define __BP_ADDR35     __BP_ADDR34, &&BP_LABEL_N(35)
+#define __BP_ADDR36     __BP_ADDR35, &&BP_LABEL_N(36)
+#define __BP_ADDR37     __BP_ADDR36, &&BP_LABEL_N(37)
+#define __BP_ADDR38     __BP_ADDR37, &&BP_LABEL_N(38)
+#define __BP_ADDR39     __BP_ADDR38, &&BP_LABEL_N(39)
+#define __BP_ADDR40     __BP_ADDR39, &&BP_LABEL_N(40)
+#define __BP_ADDR41     __BP_ADDR40, &&BP_LABEL_N(41)
+#define __BP_ADDR42     __BP_ADDR41, &&BP_LABEL_N(42)
+#define __BP_ADDR43     __BP_ADDR42, &&BP_LABEL_N(43)
+#define __BP_ADDR44     __BP_ADDR43, &&BP_LABEL_N(44)
+#define __BP_ADDR45     __BP_ADDR44, &&BP_LABEL_N(45)
+#define __BP_ADDR46     __BP_ADDR45, &&BP_LABEL_N(46)
+#define __BP_ADDR47     __BP_ADDR46, &&BP_LABEL_N(47)
+#define __BP_ADDR48     __BP_ADDR47, &&BP_LABEL_N(48)
+#define __BP_ADDR49     __BP_ADDR48, &&BP_LABEL_N(49)
+#define __BP_ADDR50     __BP_ADDR49, &&BP_LABEL_N(50)
+#define __BP_ADDR51     __BP_ADDR50, &&BP_LABEL_N(51)
+#define __BP_ADDR52     __BP_ADDR51, &&BP_LABEL_N(52)
+#define __BP_ADDR53     __BP_ADDR52, &&BP_LABEL_N(53)
+#define __BP_ADDR54     __BP_ADDR53, &&BP_LABEL_N(54)
+#define __BP_ADDR55     __BP_ADDR54, &&BP_LABEL_N(55)
+#define __BP_ADDR56     __BP_ADDR55, &&BP_LABEL_N(56)
+#define __BP_ADDR57     __BP_ADDR56, &&BP_LABEL_N(57)
+#define __BP_ADDR58     __BP_ADDR57, &&BP_LABEL_N(58)
+#define __BP_ADDR59     __BP_ADDR58, &&BP_LABEL_N(59)
+#define __BP_ADDR60     __BP_ADDR59, &&BP_LABEL_N(60)
+#define __BP_ADDR61     __BP_ADDR60, &&BP_LABEL_N(61)
+#define __BP_ADDR62     __BP_ADDR61, &&BP_LABEL_N(62)
+#define __BP_ADDR63     __BP_ADDR62, &&BP_LABEL_N(63)
+#define __BP_ADDR64     __BP_ADDR63, &&BP_LABEL_N(64)
+#define __BP_ADDR65     __BP_ADDR64, &&BP_LABEL_N(65)
+#define __BP_ADDR66     __BP_ADDR65, &&BP_LABEL_N(66)
+#define __BP_ADDR67     __BP_ADDR66, &&BP_LABEL_N(67)
+#define __BP_ADDR68     __BP_ADDR67, &&BP_LABEL_N(68)
+#define __BP_ADDR69     __BP_ADDR68, &&BP_LABEL_N(69)
+#define __BP_ADDR70     __BP_ADDR69, &&BP_LABEL_N(70)
+#define __BP_ADDR71     __BP_ADDR70, &&BP_LABEL_N(71)
+#define __BP_ADDR72     __BP_ADDR71, &&BP_LABEL_N(72)
+#define __BP_ADDR73     __BP_ADDR72, &&BP_LABEL_N(73)
+#define __BP_ADDR74     __BP_ADDR73, &&BP_LABEL_N(74)
+#define __BP_ADDR75     __BP_ADDR74, &&BP_LABEL_N(75)
+#define __BP_ADDR76     __BP_ADDR75, &&BP_LABEL_N(76)
+#define __BP_ADDR77     __BP_ADDR76, &&BP_LABEL_N(77)
+#define __BP_ADDR78     __BP_ADDR77, &&BP_LABEL_N(78)
+#define __BP_ADDR79     __BP_ADDR78, &&BP_LABEL_N(79)
+#define __BP_ADDR80     __BP_ADDR79, &&BP_LABEL_N(80)
+#define __BP_ADDR81     __BP_ADDR80, &&BP_LABEL_N(81)
+#define __BP_ADDR82     __BP_ADDR81, &&BP_LABEL_N(82)
+#define __BP_ADDR83     __BP_ADDR82, &&BP_LABEL_N(83)
+#define __BP_ADDR84     __BP_ADDR83, &&BP_LABEL_N(84)
+#define __BP_ADDR85     __BP_ADDR84, &&BP_LABEL_N(85)
+#define __BP_ADDR86     __BP_ADDR85, &&BP_LABEL_N(86)
+#define __BP_ADDR87     __BP_ADDR86, &&BP_LABEL_N(87)
+#define __BP_ADDR88     __BP_ADDR87, &&BP_LABEL_N(88)
+#define __BP_ADDR89     __BP_ADDR88, &&BP_LABEL_N(89)
+#define __BP_ADDR90     __BP_ADDR89, &&BP_LABEL_N(90)
+#define __BP_ADDR91     __BP_ADDR90, &&BP_LABEL_N(91)
+#define __BP_ADDR92     __BP_ADDR91, &&BP_LABEL_N(92)
+#define __BP_ADDR93     __BP_ADDR92, &&BP_LABEL_N(93)
+#define __BP_ADDR94     __BP_ADDR93, &&BP_LABEL_N(94)
+#define __BP_ADDR95     __BP_ADDR94, &&BP_LABEL_N(95)
+#define __BP_ADDR96     __BP_ADDR95, &&BP_LABEL_N(96)
+#define __BP_ADDR97     __BP_ADDR96, &&BP_LABEL_N(97)
+#define __BP_ADDR98     __BP_ADDR97, &&BP_LABEL_N(98)
+#define __BP_ADDR99     __BP_ADDR98, &&BP_LABEL_N(99)
+#define __BP_ADDR100    __BP_ADDR99, &&BP_LABEL_N(100)
+#define __BP_ADDR101    __BP_ADDR100, &&BP_LABEL_N(101)
+#define __BP_ADDR102    __BP_ADDR101, &&BP_LABEL_N(102)
+#define __BP_ADDR103    __BP_ADDR102, &&BP_LABEL_N(103)
+#define __BP_ADDR104    __BP_ADDR103, &&BP_LABEL_N(104)
+#define __BP_ADDR105    __BP_ADDR104, &&BP_LABEL_N(105)
+#define __BP_ADDR106    __BP_ADDR105, &&BP_LABEL_N(106)
+#define __BP_ADDR107    __BP_ADDR106, &&BP_LABEL_N(107)
+#define __BP_ADDR108    __BP_ADDR107, &&BP_LABEL_N(108)
+#define __BP_ADDR109    __BP_ADDR108, &&BP_LABEL_N(109)
+#define __BP_ADDR110    __BP_ADDR109, &&BP_LABEL_N(110)
+#define __BP_ADDR111    __BP_ADDR110, &&BP_LABEL_N(111)
+#define __BP_ADDR112    __BP_ADDR111, &&BP_LABEL_N(112)
+#define __BP_ADDR113    __BP_ADDR112, &&BP_LABEL_N(113)
+#define __BP_ADDR114    __BP_ADDR113, &&BP_LABEL_N(114)
+#define __BP_ADDR115    __BP_ADDR114, &&BP_LABEL_N(115)
+#define __BP_ADDR116    __BP_ADDR115, &&BP_LABEL_N(116)
+#define __BP_ADDR117    __BP_ADDR116, &&BP_LABEL_N(117)
+#define __BP_ADDR118    __BP_ADDR117, &&BP_LABEL_N(118)
+#define __BP_ADDR119    __BP_ADDR118, &&BP_LABEL_N(119)
+#define __BP_ADDR120    __BP_ADDR119, &&BP_LABEL_N(120)
+#define __BP_ADDR121    __BP_ADDR120, &&BP_LABEL_N(121)
+#define __BP_ADDR122    __BP_ADDR121, &&BP_LABEL_N(122)
+#define __BP_ADDR123    __BP_ADDR122, &&BP_LABEL_N(123)
+#define __BP_ADDR124    __BP_ADDR123, &&BP_LABEL_N(124)
+#define __BP_ADDR125    __BP_ADDR124, &&BP_LABEL_N(125)
+#define __BP_ADDR126    __BP_ADDR125, &&BP_LABEL_N(126)
+#define __BP_ADDR127    __BP_ADDR126, &&BP_LABEL_N(127)
+#define __BP_ADDR128    __BP_ADDR127, &&BP_LABEL_N(128)
+#define __BP_ADDR129    __BP_ADDR128, &&BP_LABEL_N(129)
+#define __BP_ADDR130    __BP_ADDR129, &&BP_LABEL_N(130)
+#define __BP_ADDR131    __BP_ADDR130, &&BP_LABEL_N(131)
+#define __BP_ADDR132    __BP_ADDR131, &&BP_LABEL_N(132)
+#define __BP_ADDR133    __BP_ADDR132, &&BP_LABEL_N(133)
+#define __BP_ADDR134    __BP_ADDR133, &&BP_LABEL_N(134)
+#define __BP_ADDR135    __BP_ADDR134, &&BP_LABEL_N(135)
+#define __BP_ADDR136    __BP_ADDR135, &&BP_LABEL_N(136)
+#define __BP_ADDR137    __BP_ADDR136, &&BP_LABEL_N(137)
+#define __BP_ADDR138    __BP_ADDR137, &&BP_LABEL_N(138)
+#define __BP_ADDR139    __BP_ADDR138, &&BP_LABEL_N(139)
+#define __BP_ADDR140    __BP_ADDR139, &&BP_LABEL_N(140)
+#define __BP_ADDR141    __BP_ADDR140, &&BP_LABEL_N(141)
+#define __BP_ADDR142    __BP_ADDR141, &&BP_LABEL_N(142)
+#define __BP_ADDR143    __BP_ADDR142, &&BP_LABEL_N(143)
+#define __BP_ADDR144    __BP_ADDR143, &&BP_LABEL_N(144)
+#define __BP_ADDR145    __BP_ADDR144, &&BP_LABEL_N(145)
+#define __BP_ADDR146    __BP_ADDR145, &&BP_LABEL_N(146)
+#define __BP_ADDR147    __BP_ADDR146, &&BP_LABEL_N(147)
+#define __BP_ADDR148    __BP_ADDR147, &&BP_LABEL_N(148)
+#define __BP_ADDR149    __BP_ADDR148, &&BP_LABEL_N(149)
+#define __BP_ADDR150    __BP_ADDR149, &&BP_LABEL_N(150)
+#define __BP_ADDR151    __BP_ADDR150, &&BP_LABEL_N(151)
+#define __BP_ADDR152    __BP_ADDR151, &&BP_LABEL_N(152)
+#define __BP_ADDR153    __BP_ADDR152, &&BP_LABEL_N(153)
+#define __BP_ADDR154    __BP_ADDR153, &&BP_LABEL_N(154)
+#define __BP_ADDR155    __BP_ADDR154, &&BP_LABEL_N(155)
+#define __BP_ADDR156    __BP_ADDR155, &&BP_LABEL_N(156)
+#define __BP_ADDR157    __BP_ADDR156, &&BP_LABEL_N(157)
+#define __BP_ADDR158    __BP_ADDR157, &&BP_LABEL_N(158)
+#define __BP_ADDR159    __BP_ADDR158, &&BP_LABEL_N(159)
+#define __BP_ADDR160    __BP_ADDR159, &&BP_LABEL_N(160)
+#define __BP_ADDR161    __BP_ADDR160, &&BP_LABEL_N(161)
+#define __BP_ADDR162    __BP_ADDR161, &&BP_LABEL_N(162)
+#define __BP_ADDR163    __BP_ADDR162, &&BP_LABEL_N(163)
+#define __BP_ADDR164    __BP_ADDR163, &&BP_LABEL_N(164)
+#define __BP_ADDR165    __BP_ADDR164, &&BP_LABEL_N(165)
+#define __BP_ADDR166    __BP_ADDR165, &&BP_LABEL_N(166)
+#define __BP_ADDR167    __BP_ADDR166, &&BP_LABEL_N(167)
+#define __BP_ADDR168    __BP_ADDR167, &&BP_LABEL_N(168)
+#define __BP_ADDR169    __BP_ADDR168, &&BP_LABEL_N(169)
+#define __BP_ADDR170    __BP_ADDR169, &&BP_LABEL_N(170)
+#define __BP_ADDR171    __BP_ADDR170, &&BP_LABEL_N(171)
+#define __BP_ADDR172    __BP_ADDR171, &&BP_LABEL_N(172)
+#define __BP_ADDR173    __BP_ADDR172, &&BP_LABEL_N(173)
+#define __BP_ADDR174    __BP_ADDR173, &&BP_LABEL_N(174)
+#define __BP_ADDR175    __BP_ADDR174, &&BP_LABEL_N(175)
+#define __BP_ADDR176    __BP_ADDR175, &&BP_LABEL_N(176)
+#define __BP_ADDR177    __BP_ADDR176, &&BP_LABEL_N(177)
+#define __BP_ADDR178    __BP_ADDR177, &&BP_LABEL_N(178)
+#define __BP_ADDR179    __BP_ADDR178, &&BP_LABEL_N(179)
+#define __BP_ADDR180    __BP_ADDR179, &&BP_LABEL_N(180)
+#define __BP_ADDR181    __BP_ADDR180, &&BP_LABEL_N(181)
+#define __BP_ADDR182    __BP_ADDR181, &&BP_LABEL_N(182)
+#define __BP_ADDR183    __BP_ADDR182, &&BP_LABEL_N(183)
+#define __BP_ADDR184    __BP_ADDR183, &&BP_LABEL_N(184)
+#define __BP_ADDR185    __BP_ADDR184, &&BP_LABEL_N(185)
+#define __BP_ADDR186    __BP_ADDR185, &&BP_LABEL_N(186)
+#define __BP_ADDR187    __BP_ADDR186, &&BP_LABEL_N(187)
+#define __BP_ADDR188    __BP_ADDR187, &&BP_LABEL_N(188)
+#define __BP_ADDR189    __BP_ADDR188, &&BP_LABEL_N(189)
+#define __BP_ADDR190    __BP_ADDR189, &&BP_LABEL_N(190)
+#define __BP_ADDR191    __BP_ADDR190, &&BP_LABEL_N(191)
+#define __BP_ADDR192    __BP_ADDR191, &&BP_LABEL_N(192)
+#define __BP_ADDR193    __BP_ADDR192, &&BP_LABEL_N(193)
+#define __BP_ADDR194    __BP_ADDR193, &&BP_LABEL_N(194)
+#define __BP_ADDR195    __BP_ADDR194, &&BP_LABEL_N(195)
+#define __BP_ADDR196    __BP_ADDR195, &&BP_LABEL_N(196)
+#define __BP_ADDR197    __BP_ADDR196, &&BP_LABEL_N(197)
+#define __BP_ADDR198    __BP_ADDR197, &&BP_LABEL_N(198)
+#define __BP_ADDR199    __BP_ADDR198, &&BP_LABEL_N(199)
+#define __BP_ADDR200    __BP_ADDR199, &&BP_LABEL_N(200)
+#define __BP_ADDR201    __BP_ADDR200, &&BP_LABEL_N(201)
+#define __BP_ADDR202    __BP_ADDR201, &&BP_LABEL_N(202)
+#define __BP_ADDR203    __BP_ADDR202, &&BP_LABEL_N(203)
+#define __BP_ADDR204    __BP_ADDR203, &&BP_LABEL_N(204)
+#define __BP_ADDR205    __BP_ADDR204, &&BP_LABEL_N(205)
+#define __BP_ADDR206    __BP_ADDR205, &&BP_LABEL_N(206)
+#define __BP_ADDR207    __BP_ADDR206, &&BP_LABEL_N(207)
+#define __BP_ADDR208    __BP_ADDR207, &&BP_LABEL_N(208)
+#define __BP_ADDR209    __BP_ADDR208, &&BP_LABEL_N(209)
+#define __BP_ADDR210    __BP_ADDR209, &&BP_LABEL_N(210)
+#define __BP_ADDR211    __BP_ADDR210, &&BP_LABEL_N(211)
+#define __BP_ADDR212    __BP_ADDR211, &&BP_LABEL_N(212)
+#define __BP_ADDR213    __BP_ADDR212, &&BP_LABEL_N(213)
+#define __BP_ADDR214    __BP_ADDR213, &&BP_LABEL_N(214)
+#define __BP_ADDR215    __BP_ADDR214, &&BP_LABEL_N(215)
+#define __BP_ADDR216    __BP_ADDR215, &&BP_LABEL_N(216)
+#define __BP_ADDR217    __BP_ADDR216, &&BP_LABEL_N(217)
+#define __BP_ADDR218    __BP_ADDR217, &&BP_LABEL_N(218)
+#define __BP_ADDR219    __BP_ADDR218, &&BP_LABEL_N(219)
+#define __BP_ADDR220    __BP_ADDR219, &&BP_LABEL_N(220)
+#define __BP_ADDR221    __BP_ADDR220, &&BP_LABEL_N(221)
+#define __BP_ADDR222    __BP_ADDR221, &&BP_LABEL_N(222)
+#define __BP_ADDR223    __BP_ADDR222, &&BP_LABEL_N(223)
+#define __BP_ADDR224    __BP_ADDR223, &&BP_LABEL_N(224)
+#define __BP_ADDR225    __BP_ADDR224, &&BP_LABEL_N(225)
+#define __BP_ADDR226    __BP_ADDR225, &&BP_LABEL_N(226)
+#define __BP_ADDR227    __BP_ADDR226, &&BP_LABEL_N(227)
+#define __BP_ADDR228    __BP_ADDR227, &&BP_LABEL_N(228)
+#define __BP_ADDR229    __BP_ADDR228, &&BP_LABEL_N(229)
+#define __BP_ADDR230    __BP_ADDR229, &&BP_LABEL_N(230)
+#define __BP_ADDR231    __BP_ADDR230, &&BP_LABEL_N(231)
+#define __BP_ADDR232    __BP_ADDR231, &&BP_LABEL_N(232)
+#define __BP_ADDR233    __BP_ADDR232, &&BP_LABEL_N(233)
+#define __BP_ADDR234    __BP_ADDR233, &&BP_LABEL_N(234)
+#define __BP_ADDR235    __BP_ADDR234, &&BP_LABEL_N(235)
+#define __BP_ADDR236    __BP_ADDR235, &&BP_LABEL_N(236)
+#define __BP_ADDR237    __BP_ADDR236, &&BP_LABEL_N(237)
+#define __BP_ADDR238    __BP_ADDR237, &&BP_LABEL_N(238)
+#define __BP_ADDR239    __BP_ADDR238, &&BP_LABEL_N(239)
+#define __BP_ADDR240    __BP_ADDR239, &&BP_LABEL_N(240)
+#define __BP_ADDR241    __BP_ADDR240, &&BP_LABEL_N(241)
+#define __BP_ADDR242    __BP_ADDR241, &&BP_LABEL_N(242)
+#define __BP_ADDR243    __BP_ADDR242, &&BP_LABEL_N(243)
+#define __BP_ADDR244    __BP_ADDR243, &&BP_LABEL_N(244)
+#define __BP_ADDR245    __BP_ADDR244, &&BP_LABEL_N(245)
+#define __BP_ADDR246    __BP_ADDR245, &&BP_LABEL_N(246)
+#define __BP_ADDR247    __BP_ADDR246, &&BP_LABEL_N(247)
+#define __BP_ADDR248    __BP_ADDR247, &&BP_LABEL_N(248)
+#define __BP_ADDR249    __BP_ADDR248, &&BP_LABEL_N(249)
+#define __BP_ADDR250    __BP_ADDR249, &&BP_LABEL_N(250)
+#define __BP_ADDR251    __BP_ADDR250, &&BP_LABEL_N(251)
+#define __BP_ADDR252    __BP_ADDR251, &&BP_LABEL_N(252)
+#define __BP_ADDR253    __BP_ADDR252, &&BP_LABEL_N(253)
+#define __BP_ADDR254    __BP_ADDR253, &&BP_LABEL_N(254)
+#define __BP_ADDR255    __BP_ADDR254, &&BP_LABEL_N(255)
+
 /* 再定义一个__BP_CAT_连接宏，供__BP_CASEN使用 */
 #define __BP_CAT_(x, y)     __BP_CAT_1(x, y)
 #define __BP_CAT_1(x, y)    x##y
@@ -353,6 +632,7 @@
  * 因此不可再次使用__BP_CAT宏，
  * 故使用__BP_CAT_宏 */
 #define __BP_CASEN(bp_nums) __BP_CAT_(__BP_CASE, bp_nums)
+#define __BP_ADDRN(bp_nums) __BP_CAT_(__BP_ADDR, bp_nums)
 
 
 /*********************************************************
@@ -368,7 +648,11 @@
  *[bp_nums]：表示bp_begin()到bp_end()之间包含的断点个数
  *[bp]：用于记录当前断点位置的生命周期为全局的变量（一个字节）
  **********************************************************/
+#if BP_USE_COMPUTED_GOTO
+#define bp_begin(bp_nums, bp)   __BP_GOTO(bp_nums, bp)
+#else
 #define bp_begin(bp_nums, bp)   __BP_HEADER(bp) __BP_CASEN(bp_nums) __BP_TAIL
+#endif
 
 
 /*********************************************************
@@ -28,6 +28,16 @@
 /* BP_STMT结束标签 */
 #define BP_STMT_LABEL_END(prefix)            BP_STMT_LABEL_N(prefix, end)
 
+/* 使用GCC/Clang的标签地址(&&label)恢复断点，断点号通过标签地址表映射为一次间接跳转，
+ * 定义为0时使用switch-goto语句块 */
+#ifndef BP_STMT_USE_COMPUTED_GOTO
+#if defined(__GNUC__) && !defined(__CC_ARM)
+#define BP_STMT_USE_COMPUTED_GOTO   1
+#else
+#define BP_STMT_USE_COMPUTED_GOTO   0
+#endif
+#endif
+
 /* BP_STMT_BEGIN的头部，switch-goto语句块 */
 #define __BP_STMT_HEADER(bp)        do {                                        \
                                     switch ((bp))                               \
@@ -40,6 +50,17 @@
                                     BP_STMT_LABEL_START(prefix):;               \
                                 } while (0); if(1)                              \
 
+/* BP_STMT_BEGIN的标签地址表部分，断点号超出范围时跳转到结束标签 */
+#define __BP_STMT_GOTO(prefix, bp_nums, bp) do {                                \
+                                    static void *const __bp_stmt_addrs[] = {    \
+                                        __BP_STMT_ADDRN(bp_nums)(prefix)        \
+                                    };                                          \
+                                    if ((unsigned int)(bp) > (unsigned int)(bp_nums)) \
+                                        goto BP_STMT_LABEL_END(prefix);         \
+                                    goto *__bp_stmt_addrs[(bp)];                \
+                                    BP_STMT_LABEL_START(prefix):;               \
+                                } while (0); if(1)                              \
+
 /* BP_STMT_BEGIN的case语句块部分 */
 #define __BP_STMT_CASE0(prefix)      case 0: goto BP_STMT_LABEL_START(prefix);
 #define __BP_STMT_CASE1(prefix)      __BP_STMT_CASE0(prefix) case 1: goto BP_STMT_LABEL_N(prefix, 1);
@@ -298,6 +319,264 @@
 #define __BP_STMT_CASE254(prefix)    __BP_STMT_CASE253(prefix) case 254: goto BP_STMT_LABEL_N(prefix, 254);
 #define __BP_STMT_CASE255(prefix)    __BP_STMT_CASE254(prefix) case 255: goto BP_STMT_LABEL_N(prefix, 255);
 
+/* BP_STMT_BEGIN的标签地址表 */
+#define __BP_STMT_ADDR0(prefix)      &&BP_STMT_LABEL_START(prefix)
+#define __BP_STMT_ADDR1(prefix)     __BP_STMT_ADDR0(prefix), &&BP_STMT_LABEL_N(prefix, 1)
+#define __BP_STMT_ADDR2(prefix)     __BP_STMT_ADDR1(prefix), &&BP_STMT_LABEL_N(prefix, 2)
+#define __BP_STMT_ADDR3(prefix)     __BP_STMT_ADDR2(prefix), &&BP_STMT_LABEL_N(prefix, 3)
+#define __BP_STMT_ADDR4(prefix)     __BP_STMT_ADDR3(prefix), &&BP_STMT_LABEL_N(prefix, 4)
+#define __BP_STMT_ADDR5(prefix)     __BP_STMT_ADDR4(prefix), &&BP_STMT_LABEL_N(prefix, 5)
+#define __BP_STMT_ADDR6(prefix)     __BP_STMT_ADDR5(prefix), &&BP_STMT_LABEL_N(prefix, 6)
+#define __BP_STMT_ADDR7(prefix)     __BP_STMT_ADDR6(prefix), &&BP_STMT_LABEL_N(prefix, 7)
+#define __BP_STMT_ADDR8(prefix)     __BP_STMT_ADDR7(prefix), &&BP_STMT_LABEL_N(prefix, 8)
+#define __BP_STMT_ADDR9(prefix)     __BP_STMT_ADDR8(prefix), &&BP_STMT_LABEL_N(prefix, 9)
+#define __BP_STMT_ADDR10(prefix)    __BP_STMT_ADDR9(prefix), &&BP_STMT_LABEL_N(prefix, 10)
+#define __BP_STMT_ADDR11(prefix)    __BP_STMT_ADDR10(prefix), &&BP_STMT_LABEL_N(prefix, 11)
+#define __BP_STMT_ADDR12(prefix)    __BP_STMT_ADDR11(prefix), &&BP_STMT_LABEL_N(prefix, 12)
+#define __BP_STMT_ADDR13(prefix)    __BP_STMT_ADDR12(prefix), &&BP_STMT_LABEL_N(prefix, 13)
+#define __BP_STMT_ADDR14(prefix)    __BP_STMT_ADDR13(prefix), &&BP_STMT_LABEL_N(prefix, 14)
+#define __BP_STMT_ADDR15(prefix)    __BP_STMT_ADDR14(prefix), &&BP_STMT_LABEL_N(prefix, 15)
+#define __BP_STMT_ADDR16(prefix)    __BP_STMT_ADDR15(prefix), &&BP_STMT_LABEL_N(prefix, 16)
+#define __BP_STMT_ADDR17(prefix)    __BP_STMT_ADDR16(prefix), &&BP_STMT_LABEL_N(prefix, 17)
+#define __BP_STMT_ADDR18(prefix)    __BP_STMT_ADDR17(prefix), &&BP_STMT_LABEL_N(prefix, 18)
+#define __BP_STMT_ADDR19(prefix)    __BP_STMT_ADDR18(prefix), &&BP_STMT_LABEL_N(prefix, 19)
+#define __BP_STMT_ADDR20(prefix)    __BP_STMT_ADDR19(prefix), &&BP_STMT_LABEL_N(prefix, 20)
+#define __BP_STMT_ADDR21(prefix)    __BP_STMT_ADDR20(prefix), &&BP_STMT_LABEL_N(prefix, 21)
+#define __BP_STMT_ADDR22(prefix)    __BP_STMT_ADDR21(prefix), &&BP_STMT_LABEL_N(prefix, 22)
+#define __BP_STMT_ADDR23(prefix)    __BP_STMT_ADDR22(prefix), &&BP_STMT_LABEL_N(prefix, 23)
+#define __BP_STMT_ADDR24(prefix)    __BP_STMT_ADDR23(prefix), &&BP_STMT_LABEL_N(prefix, 24)
+#define __BP_STMT_ADDR25(prefix)    __BP_STMT_ADDR24(prefix), &&BP_STMT_LABEL_N(prefix, 25)
+#define __BP_STMT_ADDR26(prefix)    __BP_STMT_ADDR25(prefix), &&BP_STMT_LABEL_N(prefix, 26)
+#define __BP_STMT_ADDR27(prefix)    __BP_STMT_ADDR26(prefix), &&BP_STMT_LABEL_N(prefix, 27)
+#define __BP_STMT_ADDR28(prefix)    __BP_STMT_ADDR27(prefix), &&BP_STMT_LABEL_N(prefix, 28)
+#define __BP_STMT_ADDR29(prefix)    __BP_STMT_ADDR28(prefix), &&BP_STMT_LABEL_N(prefix, 29)
+#define __BP_STMT_ADDR30(prefix)    __BP_STMT_ADDR29(prefix), &&BP_STMT_LABEL_N(prefix, 30)
+#define __BP_STMT_ADDR31(prefix)    __BP_STMT_ADDR30(prefix), &&BP_STMT_LABEL_N(prefix, 31)
+#define __BP_STMT_ADDR32(prefix)    __BP_STMT_ADDR31(prefix), &&BP_STMT_LABEL_N(prefix, 32)
+#define __BP_STMT_ADDR33(prefix)    __BP_STMT_ADDR32(prefix), &&BP_STMT_LABEL_N(prefix, 33)
+#define __BP_STMT_ADDR34(prefix)    __BP_STMT_ADDR33(prefix), &&BP_STMT_LABEL_N(prefix, 34)
+#define __BP_STMT_ADDR35(prefix)    __BP_STMT_ADDR34(prefix), &&BP_STMT_LABEL_N(prefix, 35)
+#define __BP_STMT_ADDR36(prefix)    __BP_STMT_ADDR35(prefix), &&BP_STMT_LABEL_N(prefix, 36)
+#define __BP_STMT_ADDR37(prefix)    __BP_STMT_ADDR36(prefix), &&BP_STMT_LABEL_N(prefix, 37)
+#define __BP_STMT_ADDR38(prefix)    __BP_STMT_ADDR37(prefix), &&BP_STMT_LABEL_N(prefix, 38)
+#define __BP_STMT_ADDR39(prefix)    __BP_STMT_ADDR38(prefix), &&BP_STMT_LABEL_N(prefix, 39)
+#define __BP_STMT_ADDR40(prefix)    __BP_STMT_ADDR39(prefix), &&BP_STMT_LABEL_N(prefix, 40)
+#define __BP_STMT_ADDR41(prefix)    __BP_STMT_ADDR40(prefix), &&BP_STMT_LABEL_N(prefix, 41)
+#define __BP_STMT_ADDR42(prefix)    __BP_STMT_ADDR41(prefix), &&BP_STMT_LABEL_N(prefix, 42)
+#define __BP_STMT_ADDR43(prefix)    __BP_STMT_ADDR42(prefix), &&BP_STMT_LABEL_N(prefix, 43)
+#define __BP_STMT_ADDR44(prefix)    __BP_STMT_ADDR43(prefix), &&BP_STMT_LABEL_N(prefix, 44)
+#define __BP_STMT_ADDR45(prefix)    __BP_STMT_ADDR44(prefix), &&BP_STMT_LABEL_N(prefix, 45)
+#define __BP_STMT_ADDR46(prefix)    __BP_STMT_ADDR45(prefix), &&BP_STMT_LABEL_N(prefix, 46)
+#define __BP_STMT_ADDR47(prefix)    __BP_STMT_ADDR46(prefix), &&BP_STMT_LABEL_N(prefix, 47)
+#define __BP_STMT_ADDR48(prefix)    __BP_STMT_ADDR47(prefix), &&BP_STMT_LABEL_N(prefix, 48)
+#define __BP_STMT_ADDR49(prefix)    __BP_STMT_ADDR48(prefix), &&BP_STMT_LABEL_N(prefix, 49)
+#define __BP_STMT_ADDR50(prefix)    __BP_STMT_ADDR49(prefix), &&BP_STMT_LABEL_N(prefix, 50)
+#define __BP_STMT_ADDR51(prefix)    __BP_STMT_ADDR50(prefix), &&BP_STMT_LABEL_N(prefix, 51)
+#define __BP_STMT_ADDR52(prefix)    __BP_STMT_ADDR51(prefix), &&BP_STMT_LABEL_N(prefix, 52)
+#define __BP_STMT_ADDR53(prefix)    __BP_STMT_ADDR52(prefix), &&BP_STMT_LABEL_N(prefix, 53)
+#define __BP_STMT_ADDR54(prefix)    __BP_STMT_ADDR53(prefix), &&BP_STMT_LABEL_N(prefix, 54)
+#define __BP_STMT_ADDR55(prefix)    __BP_STMT_ADDR54(prefix), &&BP_STMT_LABEL_N(prefix, 55)
+#define __BP_STMT_ADDR56(prefix)    __BP_STMT_ADDR55(prefix), &&BP_STMT_LABEL_N(prefix, 56)
+#define __BP_STMT_ADDR57(prefix)    __BP_STMT_ADDR56(prefix), &&BP_STMT_LABEL_N(prefix, 57)
+#define __BP_STMT_ADDR58(prefix)    __BP_STMT_ADDR57(prefix), &&BP_STMT_LABEL_N(prefix, 58)
+#define __BP_STMT_ADDR59(prefix)    __BP_STMT_ADDR58(prefix), &&BP_STMT_LABEL_N(prefix, 59)
+#define __BP_STMT_ADDR60(prefix)    __BP_STMT_ADDR59(prefix), &&BP_STMT_LABEL_N(prefix, 60)
+#define __BP_STMT_ADDR61(prefix)    __BP_STMT_ADDR60(prefix), &&BP_STMT_LABEL_N(prefix, 61)
+#define __BP_STMT_ADDR62(prefix)    __BP_STMT_ADDR61(prefix), &&BP_STMT_LABEL_N(prefix, 62)
+#define __BP_STMT_ADDR63(prefix)    __BP_STMT_ADDR62(prefix), &&BP_STMT_LABEL_N(prefix, 63)
+#define __BP_STMT_ADDR64(prefix)    __BP_STMT_ADDR63(prefix), &&BP_STMT_LABEL_N(prefix, 64)
+#define __BP_STMT_ADDR65(prefix)    __BP_STMT_ADDR64(prefix), &&BP_STMT_LABEL_N(prefix, 65)
+#define __BP_STMT_ADDR66(prefix)    __BP_STMT_ADDR65(prefix), &&BP_STMT_LABEL_N(prefix, 66)
+#define __BP_STMT_ADDR67(prefix)    __BP_STMT_ADDR66(prefix), &&BP_STMT_LABEL_N(prefix, 67)
+#define __BP_STMT_ADDR68(prefix)    __BP_STMT_ADDR67(prefix), &&BP_STMT_LABEL_N(prefix, 68)
+#define __BP_STMT_ADDR69(prefix)    __BP_STMT_ADDR68(prefix), &&BP_STMT_LABEL_N(prefix, 69)
+#define __BP_STMT_ADDR70(prefix)    __BP_STMT_ADDR69(prefix), &&BP_STMT_LABEL_N(prefix, 70)
+#define __BP_STMT_ADDR71(prefix)    __BP_STMT_ADDR70(prefix), &&BP_STMT_LABEL_N(prefix, 71)
+#define __BP_STMT_ADDR72(prefix)    __BP_STMT_ADDR71(prefix), &&BP_STMT_LABEL_N(prefix, 72)
+#define __BP_STMT_ADDR73(prefix)    __BP_STMT_ADDR72(prefix), &&BP_STMT_LABEL_N(prefix, 73)
+#define __BP_STMT_ADDR74(prefix)    __BP_STMT_ADDR73(prefix), &&BP_STMT_LABEL_N(prefix, 74)
+#define __BP_STMT_ADDR75(prefix)    __BP_STMT_ADDR74(prefix), &&BP_STMT_LABEL_N(prefix, 75)
+#define __BP_STMT_ADDR76(prefix)    __BP_STMT_ADDR75(prefix), &&BP_STMT_LABEL_N(prefix, 76)
+#define __BP_STMT_ADDR77(prefix)    __BP_STMT_ADDR76(prefix), &&BP_STMT_LABEL_N(prefix, 77)
+#define __BP_STMT_ADDR78(prefix)    __BP_STMT_ADDR77(prefix), &&BP_STMT_LABEL_N(prefix, 78)
+#define __BP_STMT_ADDR79(prefix)    __BP_STMT_ADDR78(prefix), &&BP_STMT_LABEL_N(prefix, 79)
+#define __BP_STMT_ADDR80(prefix)    __BP_STMT_ADDR79(prefix), &&BP_STMT_LABEL_N(prefix, 80)
+#define __BP_STMT_ADDR81(prefix)    __BP_STMT_ADDR80(prefix), &&BP_STMT_LABEL_N(prefix, 81)
+#define __BP_STMT_ADDR82(prefix)    __BP_STMT_ADDR81(prefix), &&BP_STMT_LABEL_N(prefix, 82)
+#define __BP_STMT_ADDR83(prefix)    __BP_STMT_ADDR82(prefix), &&BP_STMT_LABEL_N(prefix, 83)
+#define __BP_STMT_ADDR84(prefix)    __BP_STMT_ADDR83(prefix), &&BP_STMT_LABEL_N(prefix, 84)
+#define __BP_STMT_ADDR85(prefix)    __BP_STMT_ADDR84(prefix), &&BP_STMT_LABEL_N(prefix, 85)
+#define __BP_STMT_ADDR86(prefix)    __BP_STMT_ADDR85(prefix), &&BP_STMT_LABEL_N(prefix, 86)
+#define __BP_STMT_ADDR87(prefix)    __BP_STMT_ADDR86(prefix), &&BP_STMT_LABEL_N(prefix, 87)
+#define __BP_STMT_ADDR88(prefix)    __BP_STMT_ADDR87(prefix), &&BP_STMT_LABEL_N(prefix, 88)
+#define __BP_STMT_ADDR89(prefix)    __BP_STMT_ADDR88(prefix), &&BP_STMT_LABEL_N(prefix, 89)
+#define __BP_STMT_ADDR90(prefix)    __BP_STMT_ADDR89(prefix), &&BP_STMT_LABEL_N(prefix, 90)
+#define __BP_STMT_ADDR91(prefix)    __BP_STMT_ADDR90(prefix), &&BP_STMT_LABEL_N(prefix, 91)
+#define __BP_STMT_ADDR92(prefix)    __BP_STMT_ADDR91(prefix), &&BP_STMT_LABEL_N(prefix, 92)
+#define __BP_STMT_ADDR93(prefix)    __BP_STMT_ADDR92(prefix), &&BP_STMT_LABEL_N(prefix, 93)
+#define __BP_STMT_ADDR94(prefix)    __BP_STMT_ADDR93(prefix), &&BP_STMT_LABEL_N(prefix, 94)
+#define __BP_STMT_ADDR95(prefix)    __BP_STMT_ADDR94(prefix), &&BP_STMT_LABEL_N(prefix, 95)
+#define __BP_STMT_ADDR96(prefix)    __BP_STMT_ADDR95(prefix), &&BP_STMT_LABEL_N(prefix, 96)
+#define __BP_STMT_ADDR97(prefix)    __BP_STMT_ADDR96(prefix), &&BP_STMT_LABEL_N(prefix, 97)
+#define __BP_STMT_ADDR98(prefix)    __BP_STMT_ADDR97(prefix), &&BP_STMT_LABEL_N(prefix, 98)
+#define __BP_STMT_ADDR99(prefix)    __BP_STMT_ADDR98(prefix), &&BP_STMT_LABEL_N(prefix, 99)
+#define __BP_STMT_ADDR100(prefix)   __BP_STMT_ADDR99(prefix), &&BP_STMT_LABEL_N(prefix, 100)
+#define __BP_STMT_ADDR101(prefix)   __BP_STMT_ADDR100(prefix), &&BP_STMT_LABEL_N(prefix, 101)
+#define __BP_STMT_ADDR102(prefix)   __BP_STMT_ADDR101(prefix), &&BP_STMT_LABEL_N(prefix, 102)
+#define __BP_STMT_ADDR103(prefix)   __BP_STMT_ADDR102(prefix), &&BP_STMT_LABEL_N(prefix, 103)
+#define __BP_STMT_ADDR104(prefix)   __BP_STMT_ADDR103(prefix), &&BP_STMT_LABEL_N(prefix, 104)
+#define __BP_STMT_ADDR105(prefix)   __BP_STMT_ADDR104(prefix), &&BP_STMT_LABEL_N(prefix, 105)
+#define __BP_STMT_ADDR106(prefix)   __BP_STMT_ADDR105(prefix), &&BP_STMT_LABEL_N(prefix, 106)
+#define __BP_STMT_ADDR107(prefix)   __BP_STMT_ADDR106(prefix), &&BP_STMT_LABEL_N(prefix, 107)
+#define __BP_STMT_ADDR108(prefix)   __BP_STMT_ADDR107(prefix), &&BP_STMT_LABEL_N(prefix, 108)
+#define __BP_STMT_ADDR109(prefix)   __BP_STMT_ADDR108(prefix), &&BP_STMT_LABEL_N(prefix, 109)
+#define __BP_STMT_ADDR110(prefix)   __BP_STMT_ADDR109(prefix), &&BP_STMT_LABEL_N(prefix, 110)
+#define __BP_STMT_ADDR111(prefix)   __BP_STMT_ADDR110(prefix), &&BP_STMT_LABEL_N(prefix, 111)
+#define __BP_STMT_ADDR112(prefix)   __BP_STMT_ADDR111(prefix), &&BP_STMT_LABEL_N(prefix, 112)
+#define __BP_STMT_ADDR113(prefix)   __BP_STMT_ADDR112(prefix), &&BP_STMT_LABEL_N(prefix, 113)
+#define __BP_STMT_ADDR114(prefix)   __BP_STMT_ADDR113(prefix), &&BP_STMT_LABEL_N(prefix, 114)
+#define __BP_STMT_ADDR115(prefix)   __BP_STMT_ADDR114(prefix), &&BP_STMT_LABEL_N(prefix, 115)
+#define __BP_STMT_ADDR116(prefix)   __BP_STMT_ADDR115(prefix), &&BP_STMT_LABEL_N(prefix, 116)
+#define __BP_STMT_ADDR117(prefix)   __BP_STMT_ADDR116(prefix), &&BP_STMT_LABEL_N(prefix, 117)
+#define __BP_STMT_ADDR118(prefix)   __BP_STMT_ADDR117(prefix), &&BP_STMT_LABEL_N(prefix, 118)
+#define __BP_STMT_ADDR119(prefix)   __BP_STMT_ADDR118(prefix), &&BP_STMT_LABEL_N(prefix, 119)
+#define __BP_STMT_ADDR120(prefix)   __BP_STMT_ADDR119(prefix), &&BP_STMT_LABEL_N(prefix, 120)
+#define __BP_STMT_ADDR121(prefix)   __BP_STMT_ADDR120(prefix), &&BP_STMT_LABEL_N(prefix, 121)
+#define __BP_STMT_ADDR122(prefix)   __BP_STMT_ADDR121(prefix), &&BP_STMT_LABEL_N(prefix, 122)
+#define __BP_STMT_ADDR123(prefix)   __BP_STMT_ADDR122(prefix), &&BP_STMT_LABEL_N(prefix, 123)
+#define __BP_STMT_ADDR124(prefix)   __BP_STMT_ADDR123(prefix), &&BP_STMT_LABEL_N(prefix, 124)
+#define __BP_STMT_ADDR125(prefix)   __BP_STMT_ADDR124(prefix), &&BP_STMT_LABEL_N(prefix, 125)
+#define __BP_STMT_ADDR126(prefix)   __BP_STMT_ADDR125(prefix), &&BP_STMT_LABEL_N(prefix, 126)
+#define __BP_STMT_ADDR127(prefix)   __BP_STMT_ADDR126(prefix), &&BP_STMT_LABEL_N(prefix, 127)
+#define __BP_STMT_ADDR128(prefix)   __BP_STMT_ADDR127(prefix), &&BP_STMT_LABEL_N(prefix, 128)
+#define __BP_STMT_ADDR129(prefix)   __BP_STMT_ADDR128(prefix), &&BP_STMT_LABEL_N(prefix, 129)
+#define __BP_STMT_ADDR130(prefix)   __BP_STMT_ADDR129(prefix), &&BP_STMT_LABEL_N(prefix, 130)
+#define __BP_STMT_ADDR131(prefix)   __BP_STMT_ADDR130(prefix), &&BP_STMT_LABEL_N(prefix, 131)
+#define __BP_STMT_ADDR132(prefix)   __BP_STMT_ADDR131(prefix), &&BP_STMT_LABEL_N(prefix, 132)
+#define __BP_STMT_ADDR133(prefix)   __BP_STMT_ADDR132(prefix), &&BP_STMT_LABEL_N(prefix, 133)
+#define __BP_STMT_ADDR134(prefix)   __BP_STMT_ADDR133(prefix), &&BP_STMT_LABEL_N(prefix, 134)
+#define __BP_STMT_ADDR135(prefix)   __BP_STMT_ADDR134(prefix), &&BP_STMT_LABEL_N(prefix, 135)
+#define __BP_STMT_ADDR136(prefix)   __BP_STMT_ADDR135(prefix), &&BP_STMT_LABEL_N(prefix, 136)
+#define __BP_STMT_ADDR137(prefix)   __BP_STMT_ADDR136(prefix), &&BP_STMT_LABEL_N(prefix, 137)
+#define __BP_STMT_ADDR138(prefix)   __BP_STMT_ADDR137(prefix), &&BP_STMT_LABEL_N(prefix, 138)
+#define __BP_STMT_ADDR139(prefix)   __BP_STMT_ADDR138(prefix), &&BP_STMT_LABEL_N(prefix, 139)
+#define __BP_STMT_ADDR140(prefix)   __BP_STMT_ADDR139(prefix), &&BP_STMT_LABEL_N(prefix, 140)
+#define __BP_STMT_ADDR141(prefix)   __BP_STMT_ADDR140(prefix), &&BP_STMT_LABEL_N(prefix, 141)
+#define __BP_STMT_ADDR142(prefix)   __BP_STMT_ADDR141(prefix), &&BP_STMT_LABEL_N(prefix, 142)
+#define __BP_STMT_ADDR143(prefix)   __BP_STMT_ADDR142(prefix), &&BP_STMT_LABEL_N(prefix, 143)
+#define __BP_STMT_ADDR144(prefix)   __BP_STMT_ADDR143(prefix), &&BP_STMT_LABEL_N(prefix, 144)
+#define __BP_STMT_ADDR145(prefix)   __BP_STMT_ADDR144(prefix), &&BP_STMT_LABEL_N(prefix, 145)
+#define __BP_STMT_ADDR146(prefix)   __BP_STMT_ADDR145(prefix), &&BP_STMT_LABEL_N(prefix, 146)
+#define __BP_STMT_ADDR147(prefix)   __BP_STMT_ADDR146(prefix), &&BP_STMT_LABEL_N(prefix, 147)
+#define __BP_STMT_ADDR148(prefix)   __BP_STMT_ADDR147(prefix), &&BP_STMT_LABEL_N(prefix, 148)
+#define __BP_STMT_ADDR149(prefix)   __BP_STMT_ADDR148(prefix), &&BP_STMT_LABEL_N(prefix, 149)
+#define __BP_STMT_ADDR150(prefix)   __BP_STMT_ADDR149(prefix), &&BP_STMT_LABEL_N(prefix, 150)
+#define __BP_STMT_ADDR151(prefix)   __BP_STMT_ADDR150(prefix), &&BP_STMT_LABEL_N(prefix, 151)
+#define __BP_STMT_ADDR152(prefix)   __BP_STMT_ADDR151(prefix), &&BP_STMT_LABEL_N(prefix, 152)
+#define __BP_STMT_ADDR153(prefix)   __BP_STMT_ADDR152(prefix), &&BP_STMT_LABEL_N(prefix, 153)
+#define __BP_STMT_ADDR154(prefix)   __BP_STMT_ADDR153(prefix), &&BP_STMT_LABEL_N(prefix, 154)
+#define __BP_STMT_ADDR155(prefix)   __BP_STMT_ADDR154(prefix), &&BP_STMT_LABEL_N(prefix, 155)
+#define __BP_STMT_ADDR156(prefix)   __BP_STMT_ADDR155(prefix), &&BP_STMT_LABEL_N(prefix, 156)
+#define __BP_STMT_ADDR157(prefix)   __BP_STMT_ADDR156(prefix), &&BP_STMT_LABEL_N(prefix, 157)
+#define __BP_STMT_ADDR158(prefix)   __BP_STMT_ADDR157(prefix), &&BP_STMT_LABEL_N(prefix, 158)
+#define __BP_STMT_ADDR159(prefix)   __BP_STMT_ADDR158(prefix), &&BP_STMT_LABEL_N(prefix, 159)
+#define __BP_STMT_ADDR160(prefix)   __BP_STMT_ADDR159(prefix), &&BP_STMT_LABEL_N(prefix, 160)
+#define __BP_STMT_ADDR161(prefix)   __BP_STMT_ADDR160(prefix), &&BP_STMT_LABEL_N(prefix, 161)
+#define __BP_STMT_ADDR162(prefix)   __BP_STMT_ADDR161(prefix), &&BP_STMT_LABEL_N(prefix, 162)
+#define __BP_STMT_ADDR163(prefix)   __BP_STMT_ADDR162(prefix), &&BP_STMT_LABEL_N(prefix, 163)
+#define __BP_STMT_ADDR164(prefix)   __BP_STMT_ADDR163(prefix), &&BP_STMT_LABEL_N(prefix, 164)
+#define __BP_STMT_ADDR165(prefix)   __BP_STMT_ADDR164(prefix), &&BP_STMT_LABEL_N(prefix, 165)
+#define __BP_STMT_ADDR166(prefix)   __BP_STMT_ADDR165(prefix), &&BP_STMT_LABEL_N(prefix, 166)
+#define __BP_STMT_ADDR167(prefix)   __BP_STMT_ADDR166(prefix), &&BP_STMT_LABEL_N(prefix, 167)
+#define __BP_STMT_ADDR168(prefix)   __BP_STMT_ADDR167(prefix), &&BP_STMT_LABEL_N(prefix, 168)
+#define __BP_STMT_ADDR169(prefix)   __BP_STMT_ADDR168(prefix), &&BP_STMT_LABEL_N(prefix, 169)
+#define __BP_STMT_ADDR170(prefix)   __BP_STMT_ADDR169(prefix), &&BP_STMT_LABEL_N(prefix, 170)
+#define __BP_STMT_ADDR171(prefix)   __BP_STMT_ADDR170(prefix), &&BP_STMT_LABEL_N(prefix, 171)
+#define __BP_STMT_ADDR172(prefix)   __BP_STMT_ADDR171(prefix), &&BP_STMT_LABEL_N(prefix, 172)
+#define __BP_STMT_ADDR173(prefix)   __BP_STMT_ADDR172(prefix), &&BP_STMT_LABEL_N(prefix, 173)
+#define __BP_STMT_ADDR174(prefix)   __BP_STMT_ADDR173(prefix), &&BP_STMT_LABEL_N(prefix, 174)
+#define __BP_STMT_ADDR175(prefix)   __BP_STMT_ADDR174(prefix), &&BP_STMT_LABEL_N(prefix, 175)
+#define __BP_STMT_ADDR176(prefix)   __BP_STMT_ADDR175(prefix), &&BP_STMT_LABEL_N(prefix, 176)
+#define __BP_STMT_ADDR177(prefix)   __BP_STMT_ADDR176(prefix), &&BP_STMT_LABEL_N(prefix, 177)
+#define __BP_STMT_ADDR178(prefix)   __BP_STMT_ADDR177(prefix), &&BP_STMT_LABEL_N(prefix, 178)
+#define __BP_STMT_ADDR179(prefix)   __BP_STMT_ADDR178(prefix), &&BP_STMT_LABEL_N(prefix, 179)
+#define __BP_STMT_ADDR180(prefix)   __BP_STMT_ADDR179(prefix), &&BP_STMT_LABEL_N(prefix, 180)
+#define __BP_STMT_ADDR181(prefix)   __BP_STMT_ADDR180(prefix), &&BP_STMT_LABEL_N(prefix, 181)
+#define __BP_STMT_ADDR182(prefix)   __BP_STMT_ADDR181(prefix), &&BP_STMT_LABEL_N(prefix, 182)
+#define __BP_STMT_ADDR183(prefix)   __BP_STMT_ADDR182(prefix), &&BP_STMT_LABEL_N(prefix, 183)
+#define __BP_STMT_ADDR184(prefix)   __BP_STMT_ADDR183(prefix), &&BP_STMT_LABEL_N(prefix, 184)
+#define __BP_STMT_ADDR185(prefix)   __BP_STMT_ADDR184(prefix), &&BP_STMT_LABEL_N(prefix, 185)
+#define __BP_STMT_ADDR186(prefix)   __BP_STMT_ADDR185(prefix), &&BP_STMT_LABEL_N(prefix, 186)
+#define __BP_STMT_ADDR187(prefix)   __BP_STMT_ADDR186(prefix), &&BP_STMT_LABEL_N(prefix, 187)
+#define __BP_STMT_ADDR188(prefix)   __BP_STMT_ADDR187(prefix), &&BP_STMT_LABEL_N(prefix, 188)
+#define __BP_STMT_ADDR189(prefix)   __BP_STMT_ADDR188(prefix), &&BP_STMT_LABEL_N(prefix, 189)
+#define __BP_STMT_ADDR190(prefix)   __BP_STMT_ADDR189(prefix), &&BP_STMT_LABEL_N(prefix, 190)
+#define __BP_STMT_ADDR191(prefix)   __BP_STMT_ADDR190(prefix), &&BP_STMT_LABEL_N(prefix, 191)
+#define __BP_STMT_ADDR192(prefix)   __BP_STMT_ADDR191(prefix), &&BP_STMT_LABEL_N(prefix, 192)
+#define __BP_STMT_ADDR193(prefix)   __BP_STMT_ADDR192(prefix), &&BP_STMT_LABEL_N(prefix, 193)
+#define __BP_STMT_ADDR194(prefix)   __BP_STMT_ADDR193(prefix), &&BP_STMT_LABEL_N(prefix, 194)
+#define __BP_STMT_ADDR195(prefix)   __BP_STMT_ADDR194(prefix), &&BP_STMT_LABEL_N(prefix, 195)
+#define __BP_STMT_ADDR196(prefix)   __BP_STMT_ADDR195(prefix), &&BP_STMT_LABEL_N(prefix, 196)
+#define __BP_STMT_ADDR197(prefix)   __BP_STMT_ADDR196(prefix), &&BP_STMT_LABEL_N(prefix, 197)
+#define __BP_STMT_ADDR198(prefix)   __BP_STMT_ADDR197(prefix), &&BP_STMT_LABEL_N(prefix, 198)
+#define __BP_STMT_ADDR199(prefix)   __BP_STMT_ADDR198(prefix), &&BP_STMT_LABEL_N(prefix, 199)
+#define __BP_STMT_ADDR200(prefix)   __BP_STMT_ADDR199(prefix), &&BP_STMT_LABEL_N(prefix, 200)
+#define __BP_STMT_ADDR201(prefix)   __BP_STMT_ADDR200(prefix), &&BP_STMT_LABEL_N(prefix, 201)
+#define __BP_STMT_ADDR202(prefix)   __BP_STMT_ADDR201(prefix), &&BP_STMT_LABEL_N(prefix, 202)
+#define __BP_STMT_ADDR203(prefix)   __BP_STMT_ADDR202(prefix), &&BP_STMT_LABEL_N(prefix, 203)
+#define __BP_STMT_ADDR204(prefix)   __BP_STMT_ADDR203(prefix), &&BP_STMT_LABEL_N(prefix, 204)
+#define __BP_STMT_ADDR205(prefix)   __BP_STMT_ADDR204(prefix), &&BP_STMT_LABEL_N(prefix, 205)
+#define __BP_STMT_ADDR206(prefix)   __BP_STMT_ADDR205(prefix), &&BP_STMT_LABEL_N(prefix, 206)
+#define __BP_STMT_ADDR207(prefix)   __BP_STMT_ADDR206(prefix), &&BP_STMT_LABEL_N(prefix, 207)
+#define __BP_STMT_ADDR208(prefix)   __BP_STMT_ADDR207(prefix), &&BP_STMT_LABEL_N(prefix, 208)
+#define __BP_STMT_ADDR209(prefix)   __BP_STMT_ADDR208(prefix), &&BP_STMT_LABEL_N(prefix, 209)
+#define __BP_STMT_ADDR210(prefix)   __BP_STMT_ADDR209(prefix), &&BP_STMT_LABEL_N(prefix, 210)
+#define __BP_STMT_ADDR211(prefix)   __BP_STMT_ADDR210(prefix), &&BP_STMT_LABEL_N(prefix, 211)
+#define __BP_STMT_ADDR212(prefix)   __BP_STMT_ADDR211(prefix), &&BP_STMT_LABEL_N(prefix, 212)
+#define __BP_STMT_ADDR213(prefix)   __BP_STMT_ADDR212(prefix), &&BP_STMT_LABEL_N(prefix, 213)
+#define __BP_STMT_ADDR214(prefix)   __BP_STMT_ADDR213(prefix), &&BP_STMT_LABEL_N(prefix, 214)
+#define __BP_STMT_ADDR215(prefix)   __BP_STMT_ADDR214(prefix), &&BP_STMT_LABEL_N(prefix, 215)
+#define __BP_STMT_ADDR216(prefix)   __BP_STMT_ADDR215(prefix), &&BP_STMT_LABEL_N(prefix, 216)
+#define __BP_STMT_ADDR217(prefix)   __BP_STMT_ADDR216(prefix), &&BP_STMT_LABEL_N(prefix, 217)
+#define __BP_STMT_ADDR218(prefix)   __BP_STMT_ADDR217(prefix), &&BP_STMT_LABEL_N(prefix, 218)
+#define __BP_STMT_ADDR219(prefix)   __BP_STMT_ADDR218(prefix), &&BP_STMT_LABEL_N(prefix, 219)
+#define __BP_STMT_ADDR220(prefix)   __BP_STMT_ADDR219(prefix), &&BP_STMT_LABEL_N(prefix, 220)
+#define __BP_STMT_ADDR221(prefix)   __BP_STMT_ADDR220(prefix), &&BP_STMT_LABEL_N(prefix, 221)
+#define __BP_STMT_ADDR222(prefix)   __BP_STMT_ADDR221(prefix), &&BP_STMT_LABEL_N(prefix, 222)
+#define __BP_STMT_ADDR223(prefix)   __BP_STMT_ADDR222(prefix), &&BP_STMT_LABEL_N(prefix, 223)
+#define __BP_STMT_ADDR224(prefix)   __BP_STMT_ADDR223(prefix), &&BP_STMT_LABEL_N(prefix, 224)
+#define __BP_STMT_ADDR225(prefix)   __BP_STMT_ADDR224(prefix), &&BP_STMT_LABEL_N(prefix, 225)
+#define __BP_STMT_ADDR226(prefix)   __BP_STMT_ADDR225(prefix), &&BP_STMT_LABEL_N(prefix, 226)
+#define __BP_STMT_ADDR227(prefix)   __BP_STMT_ADDR226(prefix), &&BP_STMT_LABEL_N(prefix, 227)
+#define __BP_STMT_ADDR228(prefix)   __BP_STMT_ADDR227(prefix), &&BP_STMT_LABEL_N(prefix, 228)
+#define __BP_STMT_ADDR229(prefix)   __BP_STMT_ADDR228(prefix), &&BP_STMT_LABEL_N(prefix, 229)
+#define __BP_STMT_ADDR230(prefix)   __BP_STMT_ADDR229(prefix), &&BP_STMT_LABEL_N(prefix, 230)
+#define __BP_STMT_ADDR231(prefix)   __BP_STMT_ADDR230(prefix), &&BP_STMT_LABEL_N(prefix, 231)
+#define __BP_STMT_ADDR232(prefix)   __BP_STMT_ADDR231(prefix), &&BP_STMT_LABEL_N(prefix, 232)
+#define __BP_STMT_ADDR233(prefix)   __BP_STMT_ADDR232(prefix), &&BP_STMT_LABEL_N(prefix, 233)
+#define __BP_STMT_ADDR234(prefix)   __BP_STMT_ADDR233(prefix), &&BP_STMT_LABEL_N(prefix, 234)
+#define __BP_STMT_ADDR235(prefix)   __BP_STMT_ADDR234(prefix), &&BP_STMT_LABEL_N(prefix, 235)
+#define __BP_STMT_ADDR236(prefix)   __BP_STMT_ADDR235(prefix), &&BP_STMT_LABEL_N(prefix, 236)
+#define __BP_STMT_ADDR237(prefix)   __BP_STMT_ADDR236(prefix), &&BP_STMT_LABEL_N(prefix, 237)
+#define __BP_STMT_ADDR238(prefix)   __BP_STMT_ADDR237(prefix), &&BP_STMT_LABEL_N(prefix, 238)
+#define __BP_STMT_ADDR239(prefix)   __BP_STMT_ADDR238(prefix), &&BP_STMT_LABEL_N(prefix, 239)
+#define __BP_STMT_ADDR240(prefix)   __BP_STMT_ADDR239(prefix), &&BP_STMT_LABEL_N(prefix, 240)
+#define __BP_STMT_ADDR241(prefix)   __BP_STMT_ADDR240(prefix), &&BP_STMT_LABEL_N(prefix, 241)
+#define __BP_STMT_ADDR242(prefix)   __BP_STMT_ADDR241(prefix), &&BP_STMT_LABEL_N(prefix, 242)
+#define __BP_STMT_ADDR243(prefix)   __BP_STMT_ADDR242(prefix), &&BP_STMT_LABEL_N(prefix, 243)
+#define __BP_STMT_ADDR244(prefix)   __BP_STMT_ADDR243(prefix), &&BP_STMT_LABEL_N(prefix, 244)
+#define __BP_STMT_ADDR245(prefix)   __BP_STMT_ADDR244(prefix), &&BP_STMT_LABEL_N(prefix, 245)
+#define __BP_STMT_ADDR246(prefix)   __BP_STMT_ADDR245(prefix), &&BP_STMT_LABEL_N(prefix, 246)
+#define __BP_STMT_ADDR247(prefix)   __BP_STMT_ADDR246(prefix), &&BP_STMT_LABEL_N(prefix, 247)
+#define __BP_STMT_ADDR248(prefix)   __BP_STMT_ADDR247(prefix), &&BP_STMT_LABEL_N(prefix, 248)
+#define __BP_STMT_ADDR249(prefix)   __BP_STMT_ADDR248(prefix), &&BP_STMT_LABEL_N(prefix, 249)
+#define __BP_STMT_ADDR250(prefix)   __BP_STMT_ADDR249(prefix), &&BP_STMT_LABEL_N(prefix, 250)
+#define __BP_STMT_ADDR251(prefix)   __BP_STMT_ADDR250(prefix), &&BP_STMT_LABEL_N(prefix, 251)
+#define __BP_STMT_ADDR252(prefix)   __BP_STMT_ADDR251(prefix), &&BP_STMT_LABEL_N(prefix, 252)
+#define __BP_STMT_ADDR253(prefix)   __BP_STMT_ADDR252(prefix), &&BP_STMT_LABEL_N(prefix, 253)
+#define __BP_STMT_ADDR254(prefix)   __BP_STMT_ADDR253(prefix), &&BP_STMT_LABEL_N(prefix, 254)
+#define __BP_STMT_ADDR255(prefix)   __BP_STMT_ADDR254(prefix), &&BP_STMT_LABEL_N(prefix, 255)
+
 /* 再定义一个__BP_STMT_CAT_连接宏，供__BP_STMT_CASEN使用 */
 #define __BP_STMT_CAT_(x, y)     __BP_STMT_CAT_1(x, y)
 #define __BP_STMT_CAT_1(x, y)    x##y
@@ -306,6 +585,7 @@
  * 因此不可再次使用__BP_STMT_CAT宏，
  * 故使用__BP_STMT_CAT_宏 */
 #define __BP_STMT_CASEN(bp_nums) __BP_STMT_CAT_(__BP_STMT_CASE, bp_nums)
+#define __BP_STMT_ADDRN(bp_nums) __BP_STMT_CAT_(__BP_STMT_ADDR, bp_nums)
 
 
 /*********************************************************
@@ -322,7 +602,11 @@
  *[bp_nums]：表示bp_stmt_begin()到bp_stmt_end()之间包含的断点个数
  *[bp]：用于记录当前断点位置的变量（一个字节）
  **********************************************************/
+#if BP_STMT_USE_COMPUTED_GOTO
+#define bp_stmt_begin(prefix, bp_nums, bp)   __BP_STMT_GOTO(prefix, bp_nums, bp)
+#else
 #define bp_stmt_begin(prefix, bp_nums, bp)   __BP_STMT_HEADER(bp) __BP_STMT_CASEN(bp_nums)(prefix) __BP_STMT_TAIL(prefix)
+#endif
 
 
 /*********************************************************
@@ -13,9 +13,10 @@
 
 #endif
 
-#if defined(__ARMCC_VERSION)
+/* armclang(ARM Compiler 6)兼容GNU C扩展，与gcc使用相同的定义 */
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6000000)
 #include <compiler/armcc.h>
-#elif defined(__GNUC__)
+#elif defined(__GNUC__) || defined(__ARMCC_VERSION)
 #include <compiler/gcc.h>
 #endif
 
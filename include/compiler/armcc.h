@@ -13,4 +13,24 @@
 #define inline __inline
 #endif
 
+#ifndef __section
+#define __section(name) __attribute__((section(name)))
+#endif
+
+/* 放置于指定段的未初始化数据，armcc5需要zero_init才会将其作为ZI数据，
+ * 否则数据被放入加载映像并在启动时复制；armclang以段名前缀.bss识别ZI数据
+ */
+#ifndef __section_zi
+#if __ARMCC_VERSION < 6000000
+#define __section_zi(name) __attribute__((section(name), zero_init))
+#else
+#define __section_zi(name) __attribute__((section(name)))
+#endif
+#endif
+
+/* 编译器内存屏障，阻止编译器对屏障前后的内存访问重新排序 */
+#ifndef compiler_barrier
+#define compiler_barrier() __memory_changing()
+#endif
+
 #endif /* __COMPILER_ARMCC_H__ */
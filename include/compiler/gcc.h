@@ -13,4 +13,18 @@
 #define __asm __asm__
 #endif
 
+#ifndef __section
+#define __section(name) __attribute__((section(name)))
+#endif
+
+/* 放置于指定段的未初始化数据，段名以.bss开头时即为NOBITS段 */
+#ifndef __section_zi
+#define __section_zi(name) __attribute__((section(name)))
+#endif
+
+/* 编译器内存屏障，阻止编译器对屏障前后的内存访问重新排序 */
+#ifndef compiler_barrier
+#define compiler_barrier() __asm__ volatile("" : : : "memory")
+#endif
+
 #endif /* __COMPILER_GCC_H__ */
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __INCLUDE_DLIST_H__
+#define __INCLUDE_DLIST_H__
+
+#include <bases.h>
+
+/*********************************************************
+ *@类型说明：
+ *
+ *[dlist_node_t]：双向循环链表的节点
+ *[dlist_t]：双向循环链表
+ *
+ *@注意：
+ ***next位于节点的首部，与slist_node_t的布局相同，
+ ***可以使用slist_node_is_del等只读宏判断节点状态；
+ ***dlist_t的布局与fifo_t相同，头节点的prev即为尾节点
+ *********************************************************/
+typedef struct dlist_node_s {
+    /* 下一个节点 */
+    struct dlist_node_s *next;
+
+    /* 上一个节点 */
+    struct dlist_node_s *prev;
+} dlist_node_t, dlist_t;
+
+
+/************************************************************
+ *@简介：
+ ***双向循环链表结构体静态初始化
+ *
+ *@用法：
+ ***dlist_t list = DLIST_STATIC_INIT(list);
+ *
+ *@参数：
+ *[head]：链表变量名，非地址
+ *************************************************************/
+#define DLIST_STATIC_INIT(head) { &(head), &(head) }
+
+
+/************************************************************
+ *@简介：
+ ***双向循环链表节点结构体静态初始化
+ *
+ *@用法：
+ ***dlist_node_t node = DLIST_NODE_STATIC_INIT(node);
+ *
+ *@参数：
+ *[node]：节点变量名，非地址
+ *************************************************************/
+#define DLIST_NODE_STATIC_INIT(node) { &(node), &(node) }
+
+
+/************************************************************
+ *@简介：
+ ***获取链表的头节点
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *
+ *@返回：双向循环链表的头节点
+ *************************************************************/
+#define DLIST_HEAD(dlist)      ((dlist_node_t *)(dlist))
+
+
+/************************************************************
+ *@简介：
+ ***获取链表的第一个节点，链表为空时返回头节点
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *************************************************************/
+#define DLIST_TOP(dlist)       (DLIST_HEAD(dlist)->next)
+
+
+/************************************************************
+ *@简介：
+ ***获取链表的最后一个节点，链表为空时返回头节点
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *************************************************************/
+#define DLIST_TAIL(dlist)      (DLIST_HEAD(dlist)->prev)
+
+
+/************************************************************
+ *@简介：
+ ***获取节点的下一个节点与上一个节点
+ *
+ *@参数：
+ *[node]：节点
+ *************************************************************/
+#define DLIST_NODE_NEXT(node)      ((node)->next)
+#define DLIST_NODE_PREV(node)      ((node)->prev)
+
+
+/*********************************************************
+ *@简要：
+ ***双向循环链表初始化
+ *
+ *@约定：
+ ***1、dlist不是空指针
+ ***2、不可对正在使用的链表进行初始化
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ **********************************************************/
+#define dlist_init(dlist)           ((dlist)->next = (dlist)->prev = (dlist))
+
+
+/*********************************************************
+ *@简要：
+ ***双向循环链表节点初始化，初始化后的节点处于已删除状态
+ *
+ *@参数：
+ *[node]：节点
+ **********************************************************/
+#define dlist_node_init(node)       ((node)->next = (node)->prev = (node))
+
+
+/*********************************************************
+ *@简要：
+ ***判断双向循环链表是否为空
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *
+ *@返回值：
+ *[true]：链表为空
+ *[false]：链表非空
+ **********************************************************/
+#define dlist_is_empty(dlist)       ((dlist)->next == (dlist))
+
+
+/*********************************************************
+ *@简要：
+ ***判断节点是否处于已删除状态
+ *
+ *@参数：
+ *[node]：节点
+ *
+ *@返回值：
+ *[true]：节点已删除
+ *[false]：节点处于链表之中
+ **********************************************************/
+#define dlist_node_is_del(node)     ((node)->next == (node))
+#define dlist_node_is_ref(node)     (!dlist_node_is_del(node))
+
+
+/*********************************************************
+ *@简要：
+ ***在node之后插入节点
+ *
+ *@约定：
+ ***1、node与next_node不是空指针
+ ***2、next_node为已删除的节点
+ *
+ *@参数：
+ *[node]：链表中的节点或头节点
+ *[next_node]：被插入的节点
+ **********************************************************/
+static force_inline void dlist_node_insert_next(dlist_node_t *node, dlist_node_t *next_node)
+{
+    next_node->next = node->next;
+    next_node->prev = node;
+    node->next->prev = next_node;
+    node->next = next_node;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***在node之前插入节点
+ *
+ *@约定：
+ ***1、node与prev_node不是空指针
+ ***2、prev_node为已删除的节点
+ *
+ *@参数：
+ *[node]：链表中的节点或头节点
+ *[prev_node]：被插入的节点
+ **********************************************************/
+static force_inline void dlist_node_insert_prev(dlist_node_t *node, dlist_node_t *prev_node)
+{
+    dlist_node_insert_next(node->prev, prev_node);
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将节点从其所在的链表中删除，时间复杂度为O(1)
+ *
+ *@约定：
+ ***1、node不是空指针
+ ***2、node处于链表之中
+ *
+ *@参数：
+ *[node]：被删除的节点
+ *
+ *@返回：被删除的节点
+ **********************************************************/
+static force_inline dlist_node_t *dlist_node_del(dlist_node_t *node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    dlist_node_init(node);
+
+    return node;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将节点插入链表尾部
+ *
+ *@约定：
+ ***1、dlist与node不是空指针
+ ***2、node为已删除的节点
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[node]：被插入的节点
+ **********************************************************/
+#define dlist_push(dlist, node)         dlist_node_insert_prev(DLIST_HEAD(dlist), (node))
+
+
+/*********************************************************
+ *@简要：
+ ***将节点插入链表头部
+ *
+ *@约定：
+ ***1、dlist与node不是空指针
+ ***2、node为已删除的节点
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[node]：被插入的节点
+ **********************************************************/
+#define dlist_push_head(dlist, node)    dlist_node_insert_next(DLIST_HEAD(dlist), (node))
+
+
+/*********************************************************
+ *@简要：
+ ***从链表头部取出节点
+ *
+ *@约定：
+ ***1、dlist不是空指针
+ ***2、dlist非空
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *
+ *@返回：被取出的节点
+ **********************************************************/
+#define dlist_pop(dlist)                dlist_node_del(DLIST_TOP(dlist))
+
+
+/*********************************************************
+ *@简要：
+ ***从链表中删除节点，时间复杂度为O(1)
+ *
+ *@约定：
+ ***1、dlist与node不是空指针
+ ***2、node已删除或处于dlist之中，不能处于其他链表之中
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[node]：被删除的节点
+ *
+ *@返回值：
+ *[true]：成功从链表中删除这个节点
+ *[false]：这个节点已被删除
+ **********************************************************/
+static force_inline bool dlist_del_node(dlist_t *dlist, dlist_node_t *node)
+{
+    (void)dlist;
+
+    if (dlist_node_is_del(node)) {
+        return false;
+    }
+
+    dlist_node_del(node);
+    return true;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将链表的所有节点转移至接收链表的尾部，
+ ***转移完成后，原链表变成空
+ *
+ *@参数：
+ *[dlist]：被转移的链表
+ *[recv_dlist]: 接收节点的链表
+ **********************************************************/
+static inline void dlist_nodes_transfer_to(dlist_t *dlist, dlist_t *recv_dlist)
+{
+    if (!dlist_is_empty(dlist)) {
+        dlist->next->prev = recv_dlist->prev;
+        recv_dlist->prev->next = dlist->next;
+        dlist->prev->next = recv_dlist;
+        recv_dlist->prev = dlist->prev;
+
+        dlist_init(dlist);
+    }
+}
+
+
+/*********************************************************
+ *@简要：
+ ***通过成员指针获取外部结构
+ *
+ *@参数：
+ *[member_ptr]：节点成员的指针
+ *[type]：外部结构的类型
+ *[member]：节点成员在外部结构中的名字
+ **********************************************************/
+#define dlist_entry(member_ptr, type, member) container_of(member_ptr, type, member)
+
+
+/*********************************************************
+ *@简要：
+ ***使用node遍历整个dlist，node为当前被遍历的节点
+ *
+ *@约定：
+ ***遍历过程中不能删除node，需要删除时使用dlist_foreach_safe
+ *
+ *@用法：
+ ***  dlist_node_t *node;
+ ***
+ ***  dlist_foreach(dlist, node)
+ ***  {
+ ***      //对每个节点的处理代码
+ ***  }
+ **********************************************************/
+#define dlist_foreach(dlist, node)                              \
+    for ((node) = (dlist)->next;                                \
+        (node) != (dlist);                                      \
+        (node) = (node)->next)
+
+
+/*********************************************************
+ *@简要：
+ ***使用node遍历整个dlist，遍历过程中可以删除node
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[node]：当前被遍历的节点
+ *[safe_node]：记录下一个节点的临时变量
+ **********************************************************/
+#define dlist_foreach_safe(dlist, node, safe_node)              \
+    for ((node) = (dlist)->next, (safe_node) = (node)->next;    \
+        (node) != (dlist);                                      \
+        (node) = (safe_node), (safe_node) = (node)->next)
+
+
+/*********************************************************
+ *@简要：
+ ***使用node遍历整个dlist，并记录node的上一个节点
+ ***
+ ***与slist_foreach_record_prev的用法相同，便于在两种链表之间切换
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[node]：当前被遍历的节点
+ *[prev_node]：node的上一个节点
+ **********************************************************/
+#define dlist_foreach_record_prev(dlist, node, prev_node)       \
+    for ((prev_node) = (dlist), (node) = (dlist)->next;         \
+        (node) != (dlist);                                      \
+        (prev_node) = (node), (node) = (node)->next)
+
+
+/*********************************************************
+ *@简要：
+ ***使用entry遍历整个dlist，entry为当前被遍历的外部结构
+ *
+ *@参数：
+ *[dlist]：双向循环链表
+ *[entry]：当前被遍历的外部结构指针
+ *[member]：节点成员在外部结构中的名字
+ **********************************************************/
+#define dlist_foreach_entry(dlist, entry, member)                               \
+    for ((entry) = dlist_entry((dlist)->next, __typeof__(*(entry)), member);    \
+        &(entry)->member != (dlist);                                            \
+        (entry) = dlist_entry((entry)->member.next, __typeof__(*(entry)), member))
+
+#endif /* __INCLUDE_DLIST_H__ */
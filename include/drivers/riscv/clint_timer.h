@@ -0,0 +1,6 @@
+#ifndef __RISCV_CLINT_TIMER_H__
+#define __RISCV_CLINT_TIMER_H__
+
+void riscv_clint_timer_init(void);
+
+#endif /* __RISCV_CLINT_TIMER_H__ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_IRQ_PROFILE_H__
+#define __OS_IRQ_PROFILE_H__
+
+#include <bases.h>
+
+/*********************************************************
+ *@说明：
+ ***临界区时长统计，开启后irq_lock/irq_unlock记录最外层临界区的起止周期数，
+ ***按irq_lock的调用位置保留最长的IRQ_LOCK_PROFILE_NUMS个临界区；
+ ***统计本身在中断关闭期间进行，计时不包含统计的开销，
+ ***但会增加实际的关中断时间，只用于测试与调试
+ *
+ ***周期计数器由平台实现irq_lock_profile_cycles_get提供
+ *********************************************************/
+
+/* 临界区时长统计，定义为0时关闭，irq_lock/irq_unlock没有任何额外开销 */
+#ifndef IRQ_LOCK_PROFILE
+#define IRQ_LOCK_PROFILE        0
+#endif /* IRQ_LOCK_PROFILE */
+
+/* 保留的最长临界区个数，每个调用位置只保留一个 */
+#ifndef IRQ_LOCK_PROFILE_NUMS
+#define IRQ_LOCK_PROFILE_NUMS   8
+#endif /* IRQ_LOCK_PROFILE_NUMS */
+
+/* 一个调用位置上最长的临界区 */
+typedef struct irq_lock_section_s {
+    /* irq_lock所在的文件与行号 */
+    const char *file;
+    uint32_t line;
+
+    /* 最长的时长，以irq_lock_profile_cycles_get的计数单位记录 */
+    uint32_t cycles;
+} irq_lock_section_t;
+
+/* 统计结果 */
+typedef struct irq_lock_profile_s {
+    /* 已统计的最外层临界区个数 */
+    uint32_t count;
+
+    /* 有效的临界区个数 */
+    uint32_t nums;
+
+    /* 按时长从大到小排列的临界区 */
+    irq_lock_section_t sections[IRQ_LOCK_PROFILE_NUMS];
+} irq_lock_profile_t;
+
+/* 读取自由运行的周期计数器，由平台实现，只使用两次读取之间的差值 */
+extern uint32_t irq_lock_profile_cycles_get(void);
+
+/*********************************************************
+*@简要：
+***临界区开始，由irq_lock调用，只有最外层的临界区开始计时
+*
+*@参数：
+*[key]：关闭中断返回的键值
+*[file]：irq_lock所在的文件
+*[line]：irq_lock所在的行号
+*
+*@返回值：
+***原样返回key
+**********************************************************/
+int irq_lock_profile_enter(int key, const char *file, uint32_t line);
+
+/*********************************************************
+*@简要：
+***临界区结束，由irq_unlock在打开中断之前调用，最外层的临界区结束时记录其时长
+*
+*@参数：
+*[key]：关闭中断返回的键值
+*
+*@返回值：
+***原样返回key
+**********************************************************/
+int irq_lock_profile_exit(int key);
+
+/*********************************************************
+*@简要：
+***获取统计结果
+*
+*@参数：
+*[profile]：输出的统计结果，IRQ_LOCK_PROFILE为0时结果均为0
+**********************************************************/
+void irq_lock_profile_get(irq_lock_profile_t *profile);
+
+/*********************************************************
+*@简要：
+***清除统计结果，正在进行的临界区不受影响
+**********************************************************/
+void irq_lock_profile_reset(void);
+
+/*********************************************************
+*@简要：
+***结束当前临界区的计时，但不打开中断，
+***用于由汇编代码打开中断的场合，如抢占程序恢复被抢占的上下文
+**********************************************************/
+#if IRQ_LOCK_PROFILE
+#define irq_lock_profile_handoff()  ((void)irq_lock_profile_exit(0))
+#else
+#define irq_lock_profile_handoff()  ((void)0)
+#endif /* IRQ_LOCK_PROFILE */
+
+#endif /* __OS_IRQ_PROFILE_H__ */
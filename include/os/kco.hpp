@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KCO_HPP__
+#define __OS_KCO_HPP__
+
+/*********************************************************
+ *@说明：
+ ***C++20协程适配层，仅包含头文件
+ ***
+ ***协程帧从kslab分配器中分配，稳态下不使用堆内存；
+ ***协程由事件恢复执行，恢复发生在kevent_schedule中，优先级为协程的优先级。
+ ***协程的优先级不应该为KEVENT_PRIORITY_IMMED，否则协程将在提交者的上下文中被恢复
+ *
+ *@用法：
+ ***  struct co_frame_t { uint8_t buf[128]; };
+ ***  KSLAB_DEFINE_STATIC(co_frames, co_frame_t, 8);
+ ***
+ ***  kco::task sensor_read(kmsg_queue_t *q)
+ ***  {
+ ***      for (;;) {
+ ***          slist_node_t *msg = co_await kco::pop(q);
+ ***          co_await kco::sleep_ms(10);
+ ***      }
+ ***  }
+ ***
+ ***  kco::frame_pool_set(&co_frames);
+ ***  kco::spawn(sensor_read(&q), KEVENT_PRIORITY_MIDDLE_GROUP);
+ *********************************************************/
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <exception>
+#include <cstddef>
+
+extern "C" {
+#include <os/kevent.h>
+#include <os/ktimer.h>
+#include <os/kmsg_queue.h>
+#include <os/slab_mem.h>
+#include <arch/irq.h>
+}
+
+/* KCO错误断言 */
+#ifndef KCO_ASSERT
+#define KCO_ASSERT(expr)
+#endif /* KCO_ASSERT */
+
+namespace kco {
+
+/* 协程帧分配器，所有协程共享，块大小需要不小于最大的协程帧 */
+inline kslab_mem_t *frame_pool = nullptr;
+
+/* 设置协程帧分配器，需要在创建协程之前调用 */
+inline void frame_pool_set(kslab_mem_t *pool)
+{
+    frame_pool = pool;
+}
+
+/* 事件回调，恢复被挂起的协程 */
+inline void resume_cb(void *cb_data, kevent_t *ev)
+{
+    (void)ev;
+    std::coroutine_handle<>::from_address(cb_data).resume();
+}
+
+/* 以协程的优先级初始化恢复协程的事件 */
+inline void resume_event_init(kevent_t *ev, std::coroutine_handle<> h, uint8_t priority)
+{
+    kevent_init(ev, resume_cb, h.address(), priority);
+}
+
+/*********************************************************
+ *@类型说明：
+ ***协程任务，创建后处于挂起状态，
+ ***由spawn以独立的优先级启动，或者在其他协程中被co_await等待完成；
+ ***协程帧分配失败时co_await立即返回false，子协程不会被执行
+ *********************************************************/
+class task
+{
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /* 协程结束时，恢复等待者或者释放独立运行的协程帧 */
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(handle_type h) noexcept
+        {
+            std::coroutine_handle<> continuation = h.promise().continuation;
+
+            if (h.promise().detached) {
+                h.destroy();
+                return std::noop_coroutine();
+            }
+
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type
+    {
+        /* 启动与让出执行使用的事件 */
+        kevent_t event;
+
+        /* 等待当前协程完成的协程 */
+        std::coroutine_handle<> continuation;
+
+        /* 协程的优先级，由spawn设置或者从等待者继承 */
+        uint8_t priority = KEVENT_PRIORITY_LOWER_GROUP;
+
+        /* 由spawn启动，结束时释放协程帧 */
+        bool detached = false;
+
+        task get_return_object() noexcept
+        {
+            return task(handle_type::from_promise(*this));
+        }
+
+        static task get_return_object_on_allocation_failure() noexcept
+        {
+            return task();
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        final_awaiter final_suspend() noexcept { return {}; }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            KCO_ASSERT(0);
+            std::terminate();
+        }
+
+        /* 协程帧从frame_pool中分配，未设置frame_pool或分配失败时协程无效 */
+        static void *operator new(std::size_t size) noexcept
+        {
+            KCO_ASSERT(frame_pool != nullptr && size <= frame_pool->blk_size);
+
+            if (frame_pool == nullptr || size > frame_pool->blk_size) {
+                return nullptr;
+            }
+
+            return kslab_mem_alloc(frame_pool);
+        }
+
+        static void operator delete(void *frame) noexcept
+        {
+            kslab_mem_free(frame_pool, frame);
+        }
+    };
+
+    /* 等待子协程完成，子协程继承等待者的优先级；
+     * 子协程帧分配失败时不挂起，co_await的结果为false，由等待者处理 */
+    struct awaiter
+    {
+        handle_type h;
+
+        bool await_ready() const noexcept
+        {
+            KCO_ASSERT(h);
+            return !h || h.done();
+        }
+
+        template <class P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept
+        {
+            h.promise().continuation = parent;
+            h.promise().priority = parent.promise().priority;
+            return h;
+        }
+
+        /* 子协程是否已执行 */
+        bool await_resume() const noexcept { return static_cast<bool>(h); }
+    };
+
+    task() noexcept : h_() {}
+
+    task(task &&other) noexcept : h_(other.h_)
+    {
+        other.h_ = nullptr;
+    }
+
+    task &operator=(task &&other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            h_ = other.h_;
+            other.h_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+
+    ~task() { destroy(); }
+
+    /* 协程帧是否分配成功 */
+    bool valid() const noexcept { return static_cast<bool>(h_); }
+
+    awaiter operator co_await() && noexcept { return awaiter{h_}; }
+
+    /* 释放协程帧的所有权，由spawn使用 */
+    handle_type release() noexcept
+    {
+        handle_type h = h_;
+        h_ = nullptr;
+        return h;
+    }
+
+private:
+    explicit task(handle_type h) noexcept : h_(h) {}
+
+    void destroy() noexcept
+    {
+        if (h_) {
+            h_.destroy();
+            h_ = nullptr;
+        }
+    }
+
+    handle_type h_;
+};
+
+/*********************************************************
+ *@简要：
+ ***以独立的优先级启动协程，协程在kevent_schedule中开始执行，结束时自动释放协程帧
+ *
+ *@参数：
+ *[t]：协程任务
+ *[priority]：协程的优先级
+ *
+ *@返回值：
+ *[true]：启动成功
+ *[false]：协程帧分配失败
+ **********************************************************/
+inline bool spawn(task &&t, uint8_t priority)
+{
+    task::handle_type h = t.release();
+
+    if (!h) {
+        return false;
+    }
+
+    h.promise().priority = priority;
+    h.promise().detached = true;
+    resume_event_init(&h.promise().event, h, priority);
+    kevent_post(&h.promise().event);
+    return true;
+}
+
+/* 让出执行，允许同优先级的其他事件先执行 */
+struct yield
+{
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(task::handle_type h) noexcept
+    {
+        resume_event_init(&h.promise().event, h, h.promise().priority);
+        kevent_post(&h.promise().event);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/*********************************************************
+ *@类型说明：
+ ***可等待的事件，co_await时挂起协程，
+ ***事件被kevent_post提交后，协程在kevent_schedule中恢复执行，
+ ***事件只能在协程co_await之后被提交
+ *********************************************************/
+class event
+{
+public:
+    event() noexcept
+    {
+        kevent_init(&ev_, (kevent_cb)0, nullptr, KEVENT_PRIORITY_LOWER_GROUP);
+    }
+
+    event(const event &) = delete;
+    event &operator=(const event &) = delete;
+
+    /* 获取底层事件，交给kmsg、ktimer等接口或者由其他代码提交 */
+    kevent_t *native() noexcept { return &ev_; }
+
+    bool await_ready() const noexcept { return false; }
+
+    /* 事件可能已被交给其他接口，只更新回调与优先级，不重新初始化节点 */
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        int key = irq_lock();
+
+        ev_.cb_data = h.address();
+        ev_.priority = h.promise().priority;
+        ev_.callback = resume_cb;
+        irq_unlock(key);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    kevent_t ev_;
+};
+
+/* 睡眠至expiry时刻 */
+class sleep_until
+{
+public:
+    explicit sleep_until(ktime_tick_t expiry) noexcept : expiry_(expiry) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        ktimer_init(&timer_, resume_cb, h.address(), h.promise().priority);
+        ktimer_start_expiry(&timer_, expiry_);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    ktimer_event_t timer_;
+    ktime_tick_t expiry_;
+};
+
+/* 睡眠timeout_ms毫秒 */
+inline sleep_until sleep_ms(ktime_ms_t timeout_ms)
+{
+    return sleep_until(ktime_tick_get() + ktime_ms_to_tick(timeout_ms));
+}
+
+/* 睡眠timeout_us微秒 */
+inline sleep_until sleep_us(ktime_us_t timeout_us)
+{
+    return sleep_until(ktime_tick_get() + ktime_us_to_tick(timeout_us));
+}
+
+/*********************************************************
+ *@类型说明：
+ ***从消息队列中取出消息，队列为空时挂起协程，
+ ***被唤醒后重新取出消息，消息被其他消费者取走时继续等待
+ *********************************************************/
+class pop
+{
+public:
+    explicit pop(kmsg_queue_t *kmsg_q) noexcept : kmsg_q_(kmsg_q), msg_(nullptr) {}
+
+    bool await_ready() noexcept
+    {
+        msg_ = kmsg_queue_pop(kmsg_q_, nullptr);
+        return msg_ != nullptr;
+    }
+
+    template <class P>
+    bool await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        h_ = h;
+        kevent_init(&ev_, listen_cb, this, h.promise().priority);
+
+        /* 在设置监听时再次检查，避免错过检查之后到达的消息 */
+        msg_ = kmsg_queue_pop(kmsg_q_, &ev_);
+        return msg_ == nullptr;
+    }
+
+    slist_node_t *await_resume() const noexcept { return msg_; }
+
+private:
+    static void listen_cb(void *cb_data, kevent_t *ev)
+    {
+        pop *self = static_cast<pop *>(cb_data);
+
+        self->msg_ = kmsg_queue_pop(self->kmsg_q_, ev);
+        if (self->msg_) {
+            self->h_.resume();
+        }
+    }
+
+    kmsg_queue_t *kmsg_q_;
+    slist_node_t *msg_;
+    std::coroutine_handle<> h_;
+    kevent_t ev_;
+};
+
+/* 从slab分配器中分配内存块，无可用内存块时挂起协程，直到获得内存块 */
+class alloc
+{
+public:
+    explicit alloc(kslab_mem_t *slab) noexcept : slab_(slab) {}
+
+    bool await_ready() noexcept
+    {
+        slab_ev_.mem_blk = kslab_mem_alloc(slab_);
+        return slab_ev_.mem_blk != nullptr;
+    }
+
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        kslab_event_init(&slab_ev_, resume_cb, h.address(), h.promise().priority);
+        kslab_mem_wait(slab_, &slab_ev_);
+    }
+
+    void *await_resume() const noexcept { return slab_ev_.mem_blk; }
+
+private:
+    kslab_mem_t *slab_;
+    kslab_event_t slab_ev_;
+};
+
+} /* namespace kco */
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* __OS_KCO_HPP__ */
@@ -10,6 +10,11 @@
 #include <os/slab_mem.h>
 #include <os/ktask_co.h>
 #include <os/kmsg_queue.h>
+#include <os/kring_queue.h>
+#include <os/ktopic.h>
+#include <os/kmutex.h>
+#include <os/ksem.h>
+#include <os/kirq.h>
 #include <arch/irq.h>
 #include <bp.h>
 
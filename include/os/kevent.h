@@ -8,9 +8,97 @@
 #include <bases.h>
 #include <fifo.h>
 #include <lifo.h>
+#include <dlist.h>
+#include <pheap.h>
+
+/*********************************************************
+ *@说明：
+ ***KEVENT_NODE_DLIST为1时，事件使用双向链表节点，
+ ***每个事件增加一个指针的空间，事件从等待队列、定时器队列及就绪队列中的删除为O(1)；
+ ***KEVENT_NODE_PHEAP为1时，事件使用配对堆节点，每个事件增加三个字的空间，
+ ***按优先级插入为O(1)，取出与删除为均摊O(log n)，适用于等待者较多的队列；
+ ***均为0时使用单向链表节点，按优先级插入与删除需要遍历所在的队列
+ *********************************************************/
+#ifndef KEVENT_NODE_DLIST
+#define KEVENT_NODE_DLIST   0
+#endif /* KEVENT_NODE_DLIST */
+
+#ifndef KEVENT_NODE_PHEAP
+#define KEVENT_NODE_PHEAP   0
+#endif /* KEVENT_NODE_PHEAP */
+
+#if KEVENT_NODE_DLIST && KEVENT_NODE_PHEAP
+#error "KEVENT_NODE_DLIST and KEVENT_NODE_PHEAP cannot be enabled at the same time"
+#endif
+
+/* 调度栈监视，记录每个优先级组的事件执行时调度的最大嵌套层数与最低栈指针，定义为0时关闭 */
+#ifndef KEVENT_STACK_MONITOR
+#define KEVENT_STACK_MONITOR    0
+#endif /* KEVENT_STACK_MONITOR */
+
+#if KEVENT_NODE_PHEAP
+typedef pheap_node_t kevent_node_t;
+typedef pheap_t kevent_queue_t;
+
+/* 堆中的事件总是按优先级排序，kevent_queue_push与kevent_fifo_priority_push相同 */
+#define KEVENT_NODE_STATIC_INIT(node)           PHEAP_NODE_STATIC_INIT(node)
+#define KEVENT_QUEUE_STATIC_INIT(queue)         PHEAP_STATIC_INIT(queue)
+#define KEVENT_QUEUE_TOP(queue)                 PHEAP_TOP(queue)
+#define kevent_node_init(node)                  pheap_node_init(node)
+#define kevent_node_is_del(node)                pheap_node_is_del(node)
+#define kevent_queue_init(queue)                pheap_init(queue)
+#define kevent_queue_is_empty(queue)            pheap_is_empty(queue)
+#define kevent_queue_push(queue, node)          pheap_push((queue), (node), kevent_node_priority_before)
+#define kevent_queue_pop(queue)                 pheap_pop((queue), kevent_node_priority_before)
+#define kevent_queue_del_node(queue, node)      pheap_del_node((queue), (node), kevent_node_priority_before)
+#define kevent_queue_nodes_transfer_to(queue, recv_queue)   \
+    pheap_nodes_transfer_to((queue), (recv_queue), kevent_node_priority_before)
+#elif KEVENT_NODE_DLIST
+typedef dlist_node_t kevent_node_t;
+typedef dlist_t kevent_queue_t;
+
+#define KEVENT_NODE_STATIC_INIT(node)           DLIST_NODE_STATIC_INIT(node)
+#define KEVENT_QUEUE_STATIC_INIT(queue)         DLIST_STATIC_INIT(queue)
+#define KEVENT_QUEUE_TOP(queue)                 DLIST_TOP(queue)
+#define KEVENT_QUEUE_TAIL(queue)                DLIST_TAIL(queue)
+#define kevent_node_init(node)                  dlist_node_init(node)
+#define kevent_node_is_del(node)                dlist_node_is_del(node)
+#define kevent_queue_init(queue)                dlist_init(queue)
+#define kevent_queue_is_empty(queue)            dlist_is_empty(queue)
+#define kevent_queue_push(queue, node)          dlist_push((queue), (node))
+#define kevent_queue_pop(queue)                 dlist_pop(queue)
+#define kevent_queue_insert_next(queue, prev_node, node)    \
+    dlist_node_insert_next((prev_node), (node))
+#define kevent_queue_del_node(queue, node)      dlist_del_node((queue), (node))
+#define kevent_queue_nodes_transfer_to(queue, recv_queue)   \
+    dlist_nodes_transfer_to((queue), (recv_queue))
+#define kevent_queue_foreach_record_prev(queue, node, prev_node)    \
+    dlist_foreach_record_prev((queue), (node), (prev_node))
+#else
+typedef slist_node_t kevent_node_t;
+typedef fifo_t kevent_queue_t;
+
+#define KEVENT_NODE_STATIC_INIT(node)           SLIST_NODE_STATIC_INIT(node)
+#define KEVENT_QUEUE_STATIC_INIT(queue)         FIFO_STATIC_INIT(queue)
+#define KEVENT_QUEUE_TOP(queue)                 FIFO_TOP(queue)
+#define KEVENT_QUEUE_TAIL(queue)                FIFO_TAIL(queue)
+#define kevent_node_init(node)                  slist_node_init(node)
+#define kevent_node_is_del(node)                slist_node_is_del(node)
+#define kevent_queue_init(queue)                fifo_init(queue)
+#define kevent_queue_is_empty(queue)            fifo_is_empty(queue)
+#define kevent_queue_push(queue, node)          fifo_push((queue), (node))
+#define kevent_queue_pop(queue)                 fifo_pop(queue)
+#define kevent_queue_insert_next(queue, prev_node, node)    \
+    fifo_node_insert_next((queue), (prev_node), (node))
+#define kevent_queue_del_node(queue, node)      fifo_del_node((queue), (node))
+#define kevent_queue_nodes_transfer_to(queue, recv_queue)   \
+    fifo_nodes_transfer_to((queue), (recv_queue))
+#define kevent_queue_foreach_record_prev(queue, node, prev_node)    \
+    slist_foreach_record_prev(FIFO_LIST(queue), (node), (prev_node))
+#endif /* KEVENT_NODE_PHEAP */
 
 typedef struct kevent_s {
-    slist_node_t node;
+    kevent_node_t node;
 
     void (*callback)(void *cb_data, struct kevent_s *e);
 
@@ -22,9 +110,16 @@ typedef struct kevent_s {
 
     uint8_t bp;
 
-    uint8_t unused;
+    /* 事件标志，KEVENT_FLAG_* */
+    uint8_t flags;
 } kevent_t;
 
+/* 事件正在进行带超时的等待，唤醒者需要停止其超时定时器 */
+#define KEVENT_FLAG_TIMED       BIT(0)
+
+/* 事件是消息队列多路等待的代理事件，唤醒者需要通知其所属的多路等待 */
+#define KEVENT_FLAG_SELECT      BIT(1)
+
 /************************************************************
  *@简介：
  ***事件结构体静态初始化
@@ -40,21 +135,30 @@ typedef struct kevent_s {
  *************************************************************/
 #define KEVENT_STATIC_INIT(event, callback, cb_data, priority) \
 {                                               \
-    SLIST_NODE_STATIC_INIT((event).node),       \
+    KEVENT_NODE_STATIC_INIT((event).node),      \
     (callback),                                 \
     (cb_data),                                  \
-    (priority), 0, 0                            \
+    (priority), 0, 0, 0                         \
 }
 
 /* 事件回调类型定义 */
 typedef void (*kevent_cb)(void *, kevent_t *);
 
+/* 优先级组的调度栈使用情况 */
+typedef struct kevent_stack_info_s {
+    /* 该组事件开始执行时观察到的最低栈指针，0表示该组尚未执行过事件 */
+    uintptr_t sp_min;
+
+    /* 该组事件执行时调度的最大嵌套层数，1表示没有嵌套在其他事件之中 */
+    uint8_t depth_peak;
+} kevent_stack_info_t;
+
 /*********************************************************
  *@说明：
  ***事件相关成员变量引用
  *********************************************************/
 /* 事件的节点 */
-#define KEVENT_NODE(event)   ((slist_node_t *)(event))
+#define KEVENT_NODE(event)   ((kevent_node_t *)(event))
 
 /* 节点上的事件 */
 #define KEVENT_OF_NODE(_node) ((kevent_t *)(_node))
@@ -69,7 +173,15 @@ typedef void (*kevent_cb)(void *, kevent_t *);
 #define KEVENT_PRIORITY(event) ((event)->priority)
 
 /* 事件已被引用或者处于队列之中 */
-#define kevent_is_ref(event)    slist_node_is_ref(&(event)->node)
+#define kevent_is_ref(event)    (!kevent_node_is_del(&(event)->node))
+
+#if KEVENT_NODE_PHEAP
+/* 事件堆的排序回调，优先级高的事件在前 */
+static force_inline bool kevent_node_priority_before(const pheap_node_t *a, const pheap_node_t *b)
+{
+    return ((const kevent_t *)a)->priority > ((const kevent_t *)b)->priority;
+}
+#endif /* KEVENT_NODE_PHEAP */
 
 /************************************************************
  *@简介：
@@ -89,9 +201,10 @@ static force_inline void kevent_init(kevent_t *event,
     event->priority = priority;
     event->is_ready = 0;
     event->bp = 0;
+    event->flags = 0;
     event->cb_data = ctx;
     event->callback = ecb;
-    slist_node_init(&event->node);
+    kevent_node_init(&event->node);
 }
 
 
@@ -107,9 +220,10 @@ static inline void kevent_init_inherit(kevent_t *event, const kevent_t *parent)
 {
     event->priority = parent->priority;
     event->is_ready = 0;
+    event->flags = 0;
     event->cb_data = parent->cb_data;
     event->callback = parent->callback;
-    slist_node_init(&event->node);
+    kevent_node_init(&event->node);
 }
 
 enum
@@ -138,6 +252,57 @@ enum
 #define KEVENT_READY_GROUP_PRIORITY_MASK    0xC0
 #define KEVENT_READY_GROUP_PRIORITY_SHIFT   6
 
+/*********************************************************
+ *@说明：
+ ***KEVENT_IRQ_GROUP_NUMS为最高的几个优先级组由NVIC中断调度，0表示所有事件组均由PendSV调度；
+ ***最高优先级组使用KEVENT_IRQ_GROUP_IRQN_BASE号中断，其余的组依次使用后续的中断号，
+ ***这些中断需要由应用使能，并按事件组的高低设置高于PendSV的优先级，
+ ***中断处理程序使用KEVENT_IRQ_GROUP_HANDLER_DEFINE定义；
+ ***提交到这些组的事件直接挂起其中断，由NVIC完成抢占与尾链，
+ ***同一组中的事件按优先级依次执行，相互之间不会抢占
+ *********************************************************/
+#ifndef KEVENT_IRQ_GROUP_NUMS
+#define KEVENT_IRQ_GROUP_NUMS       0
+#endif /* KEVENT_IRQ_GROUP_NUMS */
+
+/* 中断号与芯片相关，没有可用的默认值，0号中断通常已被外设占用 */
+#if KEVENT_IRQ_GROUP_NUMS > 0 && !defined(KEVENT_IRQ_GROUP_IRQN_BASE)
+#error "KEVENT_IRQ_GROUP_IRQN_BASE must be defined when KEVENT_IRQ_GROUP_NUMS is not 0"
+#endif
+
+/* 没有由中断调度的事件组时不会使用，仅用于编译 */
+#ifndef KEVENT_IRQ_GROUP_IRQN_BASE
+#define KEVENT_IRQ_GROUP_IRQN_BASE  0
+#endif /* KEVENT_IRQ_GROUP_IRQN_BASE */
+
+#if KEVENT_IRQ_GROUP_NUMS > 4
+#error "KEVENT_IRQ_GROUP_NUMS cannot exceed the number of priority groups"
+#endif
+
+/* 第一个由中断调度的事件组 */
+#define KEVENT_IRQ_GROUP_FIRST      (KEVENT_PRIORITY_GROUP_COUNT - KEVENT_IRQ_GROUP_NUMS)
+
+/* 事件组绑定的中断号 */
+#define KEVENT_IRQ_GROUP_IRQN(ready_group)  \
+    (KEVENT_IRQ_GROUP_IRQN_BASE + (KEVENT_PRIORITY_GROUP_COUNT - 1 - (ready_group)))
+
+/************************************************************
+ *@简介：
+ ***定义事件组的中断处理程序
+ *
+ *@用法：
+ ***KEVENT_IRQ_GROUP_HANDLER_DEFINE(SWI0_IRQHandler, KEVENT_PRIORITY_HIGHEST_GROUP);
+ *
+ *@参数：
+ *[handler]：中断处理程序的名称，与向量表中的名称一致
+ *[group_priority]：事件组的优先级，KEVENT_PRIORITY_*_GROUP
+ *************************************************************/
+#define KEVENT_IRQ_GROUP_HANDLER_DEFINE(handler, group_priority)                \
+void handler(void)                                                              \
+{                                                                               \
+    kevent_irq_group_schedule((group_priority) >> KEVENT_READY_GROUP_PRIORITY_SHIFT); \
+}
+
 /*********************************************************
 *@简要：
 ***检查事件是否已经就绪(将被调度)
@@ -160,7 +325,7 @@ static force_inline bool kevent_is_ready(kevent_t *e)
 /*
  * epfifo为事件队列，并按事件优先级插入事件
  */
-void kevent_fifo_priority_push(fifo_t *epfifo, kevent_t *event);
+void kevent_fifo_priority_push(kevent_queue_t *epfifo, kevent_t *event);
 
 /*********************************************************
 *@简要：
@@ -194,6 +359,53 @@ void kevent_cancel(kevent_t *e);
 **********************************************************/
 void kevent_schedule(void);
 
+/*********************************************************
+*@简要：
+***检查是否存在比当前正在调度的优先级更高的就绪事件，
+***不存在时清除调度挂起标识
+*
+*@说明：
+***由抢占程序在进入时调用，无需抢占时直接返回被中断的上下文
+*
+*@返回值：
+*[true]：需要抢占
+*[false]：没有可以抢占的事件
+**********************************************************/
+bool kevent_preempt_check(void);
+
+/*********************************************************
+*@简要：
+***抢占程序使用的调度，与kevent_schedule相同，但返回时中断保持关闭
+*
+*@说明：
+***抢占程序在中断关闭的状态下恢复被抢占的上下文，
+***期间提交的事件在上下文恢复完成之后再次挂起抢占，
+***避免在未完全恢复的伪造现场之上嵌套新的现场
+**********************************************************/
+void kevent_preempt_schedule(void);
+
+/*********************************************************
+*@简要：
+***执行由中断调度的事件组中所有的就绪事件
+*
+*@说明：
+***由KEVENT_IRQ_GROUP_HANDLER_DEFINE定义的中断处理程序调用
+*
+*@参数：
+*[ready_group]：事件组序号，优先级右移KEVENT_READY_GROUP_PRIORITY_SHIFT
+**********************************************************/
+void kevent_irq_group_schedule(uint8_t ready_group);
+
+/*********************************************************
+*@简要：
+***获取优先级组的调度栈使用情况，KEVENT_STACK_MONITOR为0时结果均为0
+*
+*@参数：
+*[ready_group]：事件组序号，优先级右移KEVENT_READY_GROUP_PRIORITY_SHIFT
+*[info]：输出的调度栈使用情况
+**********************************************************/
+void kevent_stack_info_get(uint8_t ready_group, kevent_stack_info_t *info);
+
 /*********************************************************
 *@简要：
 ***判断事件调度器是否处于busy状态
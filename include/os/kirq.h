@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KIRQ_H__
+#define __OS_KIRQ_H__
+
+#include <os/kevent.h>
+
+/*********************************************************
+ *@说明：
+ ***中断与事件的绑定表，由表生成中断向量的处理程序，
+ ***处理程序直接调用应答函数并提交绑定的事件，没有函数指针的间接调用；
+ ***立即事件在处理程序中内联执行其回调
+ *
+ *@用法：
+ ***#define APP_IRQ_TABLE(X)                                        \
+ ***    X(USART1_IRQHandler, uart_rx_event, uart_rx_ack)            \
+ ***    X(EXTI0_IRQHandler, key_event, KIRQ_NO_ACK)
+ ***
+ ***KIRQ_TABLE_DEFINE(APP_IRQ_TABLE)
+ ***
+ ***每一项依次为：中断处理程序的名称(与向量表中的名称一致)，绑定的事件变量(非地址)，
+ ***应答函数(void (void)，用于清除外设的中断标志，可以为static inline)
+ *********************************************************/
+
+/* 不需要应答的中断 */
+#define KIRQ_NO_ACK     kirq_no_ack
+
+static force_inline void kirq_no_ack(void)
+{
+}
+
+/*********************************************************
+ *@简要：
+ ***在中断中提交事件，立即事件在当前的中断中内联执行
+ *
+ *@参数：
+ *[e]：被提交的事件
+ **********************************************************/
+static force_inline void kirq_post(kevent_t *e)
+{
+    if (e->priority == KEVENT_PRIORITY_IMMED) {
+        e->callback(e->cb_data, e);
+    } else {
+        kevent_post(e);
+    }
+}
+
+/************************************************************
+ *@简介：
+ ***定义一个中断处理程序，应答中断并提交绑定的事件
+ *
+ *@参数：
+ *[handler]：中断处理程序的名称
+ *[event]：绑定的事件变量名，非地址
+ *[ack]：应答函数，KIRQ_NO_ACK表示不需要应答
+ *************************************************************/
+#define KIRQ_HANDLER_DEFINE(handler, event, ack)    \
+void handler(void)                                  \
+{                                                   \
+    ack();                                          \
+    kirq_post(&(event));                            \
+}
+
+/************************************************************
+ *@简介：
+ ***由绑定表生成所有的中断处理程序
+ *
+ *@参数：
+ *[table]：绑定表，以KIRQ_HANDLER_DEFINE的形式展开每一项
+ *************************************************************/
+#define KIRQ_TABLE_DEFINE(table)    table(KIRQ_HANDLER_DEFINE)
+
+#endif /* __OS_KIRQ_H__ */
@@ -6,34 +6,246 @@
 #define __OS_MSG_QUEUE_H__
 
 #include <os/kevent.h>
+#include <os/ktimer.h>
 
 typedef struct kmsg_queue_s {
     /* 消息队列，按先进先出方式进队 */
     fifo_t msg_q;
 
-    /* 通常只有一个处理者，因此不需要使用FIFO */
-    lifo_t wait_q;
+    /* 监听事件，按优先级排序，相同优先级按先进先出排序 */
+    kevent_queue_t wait_q;
+
+    /* 等待队列空间的生产者事件，按优先级排序 */
+    kevent_queue_t push_wait_q;
+
+    /* 队列中的消息个数，不限制容量的队列中可能超过uint16_t的范围 */
+    uint32_t count;
+
+    /* 队列容量，为0时表示不限制容量 */
+    uint16_t capacity;
+
+    /* 消息队列标志，KMSG_QUEUE_FLAG_* */
+    uint8_t flags;
 } kmsg_queue_t;
 
-#define KMSG_QUEUE_STATIC_INIT(kmsg_q)  \
-{ FIFO_STATIC_INIT((kmsg_q).msg_q), LIFO_STATIC_INIT((kmsg_q).wait_q) }
+/* 消息入队时唤醒所有的监听事件，否则每条消息只唤醒最高优先级的一个监听事件 */
+#define KMSG_QUEUE_FLAG_WAKE_ALL    BIT(0)
+
+/* 生产者等待事件，队列有空间时消息将被加入队列，并触发该事件 */
+typedef struct kmsg_push_event_s {
+    kevent_t event;
+    slist_node_t *msg;
+} kmsg_push_event_t;
+
+/* 带超时的监听事件 */
+typedef struct kmsg_timed_event_s {
+    kevent_t event;
+    ktimeout_t timeout;
+} kmsg_timed_event_t;
+
+#define kmsg_timed_event_init(timed_event, ecb, ctx, priority)      \
+    kevent_init(&(timed_event)->event, (ecb), (ctx), (priority))
+
+#define kmsg_timed_event_init_inherit(timed_event, parent)          \
+    kevent_init_inherit(&(timed_event)->event, (parent))
+
+/* 带超时的监听事件到事件的转换 */
+#define KMSG_TIMED_EVENT_EVENT(timed_event)     (&(timed_event)->event)
+#define KMSG_TIMED_EVENT_OF_EVENT(event)        ((kmsg_timed_event_t *)(event))
+
+/* 获取等待的结果，KWAIT_OK或KWAIT_TIMEOUT */
+#define kmsg_timed_event_status(timed_event)    ktimeout_status_get(&(timed_event)->timeout)
+
+struct kmsg_select_s;
+
+/* 多路等待中的一个消息队列 */
+typedef struct kmsg_select_entry_s {
+    /* 注册在消息队列上的代理事件 */
+    kevent_t proxy;
+
+    /* 被等待的消息队列 */
+    struct kmsg_queue_s *kmsg_q;
+
+    /* 所属的多路等待 */
+    struct kmsg_select_s *select;
+} kmsg_select_entry_t;
+
+/* 消息队列多路等待，一个监听事件同时等待多个消息队列 */
+typedef struct kmsg_select_s {
+    /* 任意消息队列非空时触发的监听事件 */
+    kevent_t *listen_ev;
+
+    /* 被等待的消息队列 */
+    kmsg_select_entry_t *entries;
+
+    /* 被等待的消息队列个数 */
+    uint8_t nums;
+
+    /* 已就绪的消息队列序号，-1表示无就绪的消息队列 */
+    int8_t ready;
+} kmsg_select_t;
+
+#define KMSG_QUEUE_STATIC_INIT(kmsg_q)  KMSG_QUEUE_BOUNDED_STATIC_INIT(kmsg_q, 0)
+
+#define KMSG_QUEUE_BOUNDED_STATIC_INIT(kmsg_q, capacity)    \
+{                                                           \
+    FIFO_STATIC_INIT((kmsg_q).msg_q),                       \
+    KEVENT_QUEUE_STATIC_INIT((kmsg_q).wait_q),              \
+    KEVENT_QUEUE_STATIC_INIT((kmsg_q).push_wait_q),         \
+    0, (capacity), 0                                        \
+}
+
+/* 生产者等待事件初始化 */
+#define KMSG_PUSH_EVENT_STATIC_INIT(push_event, ecb, cb_data, priority) \
+{                                                                       \
+    KEVENT_STATIC_INIT((push_event).event, ecb, cb_data, priority),     \
+    0                                                                   \
+}
+
+#define kmsg_push_event_init(push_event, ecb, ctx, priority)        \
+    do                                                              \
+    {                                                               \
+        kevent_init(&(push_event)->event, (ecb), (ctx), (priority));\
+        (push_event)->msg = 0;                                      \
+    } while (0)
+
+#define kmsg_push_event_init_inherit(push_event, parent)            \
+    do                                                              \
+    {                                                               \
+        kevent_init_inherit(&(push_event)->event, (parent));        \
+        (push_event)->msg = 0;                                      \
+    } while (0)
+
+/* 生产者等待事件到节点的转换 */
+#define KMSG_PUSH_EVENT_EVENT(push_event)   (&(push_event)->event)
+#define KMSG_PUSH_EVENT_OF_EVENT(event)     ((kmsg_push_event_t *)(event))
+#define KMSG_PUSH_EVENT_OF_NODE(node)       KMSG_PUSH_EVENT_OF_EVENT(KEVENT_OF_NODE(node))
 
 static inline void kmsg_queue_init(kmsg_queue_t *kmsg_q)
 {
     fifo_init(&kmsg_q->msg_q);
-    lifo_init(&kmsg_q->wait_q);
+    kevent_queue_init(&kmsg_q->wait_q);
+    kevent_queue_init(&kmsg_q->push_wait_q);
+    kmsg_q->count = 0;
+    kmsg_q->capacity = 0;
+    kmsg_q->flags = 0;
+}
+
+/* 初始化一个有容量限制的消息队列 */
+static inline void kmsg_queue_init_bounded(kmsg_queue_t *kmsg_q, uint16_t capacity)
+{
+    kmsg_queue_init(kmsg_q);
+    kmsg_q->capacity = capacity;
 }
 
+/* 设置消息入队时是否唤醒所有的监听事件 */
+static inline void kmsg_queue_wake_all_set(kmsg_queue_t *kmsg_q, bool wake_all)
+{
+    if (wake_all) {
+        kmsg_q->flags |= KMSG_QUEUE_FLAG_WAKE_ALL;
+    } else {
+        kmsg_q->flags &= ~KMSG_QUEUE_FLAG_WAKE_ALL;
+    }
+}
 
-/* 添加消息至消息队列
- * 若消息队列存在监听事件，该操作结束后将触发监听事件
+
+/* 添加消息至消息队列，该操作不受队列容量的限制
+ * 若消息队列存在监听事件，该操作结束后将触发优先级最高的监听事件
  */
 void kmsg_queue_push(kmsg_queue_t *kmsg_q, slist_node_t *msg);
 
+/*
+ * 尝试添加消息至消息队列
+ * 若队列已满返回false，否则与kmsg_queue_push相同
+ */
+bool kmsg_queue_try_push(kmsg_queue_t *kmsg_q, slist_node_t *msg);
+
+/* kmsg_queue_push_wait的结果 */
+enum
+{
+    /* 队列已满，push_ev正在等待队列空间 */
+    KMSG_PUSH_WAIT = 0,
+
+    /* 消息已被立即加入队列 */
+    KMSG_PUSH_OK = 1,
+
+    /* 消息已处于队列之中，未被再次加入，push_ev也不会被触发 */
+    KMSG_PUSH_LINKED = -1
+};
+
+/*
+ * 添加消息至消息队列，若队列已满则等待
+ * 若消息被立即加入队列返回KMSG_PUSH_OK，且不会触发push_ev
+ * 若队列已满返回KMSG_PUSH_WAIT，push_ev按优先级等待队列空间，空间可用时消息被加入队列并触发push_ev
+ * 若消息已处于队列之中返回KMSG_PUSH_LINKED，调用者不应该等待push_ev
+ */
+int kmsg_queue_push_wait(kmsg_queue_t *kmsg_q, slist_node_t *msg, kmsg_push_event_t *push_ev);
+
+/*
+ * 取消kmsg_queue_push_wait的等待，返回false表示消息已经被加入队列
+ */
+bool kmsg_queue_push_wait_cancel(kmsg_queue_t *kmsg_q, kmsg_push_event_t *push_ev);
+
 /* 
  * 从消息队列中取出消息
  * 传入一个监听事件，若队列非空返回队列头部的消息。若队列为空返回NULL，并设置监听事件
  */
 slist_node_t *kmsg_queue_pop(kmsg_queue_t *kmsg_q, kevent_t *listen_ev);
 
+/*
+ * 带超时地从消息队列中取出消息
+ * 若队列非空返回队列头部的消息。若队列为空返回NULL，并设置监听事件，
+ * 监听事件在消息到达或者到达expiry时被触发，由kmsg_timed_event_status区分两者
+ */
+slist_node_t *kmsg_queue_pop_timed(kmsg_queue_t *kmsg_q, kmsg_timed_event_t *listen_ev, ktime_tick_t expiry);
+
+/*
+ * 在一次临界区中取出消息队列中的所有消息，并转移至out的尾部
+ * 传入一个监听事件，若队列非空返回true。若队列为空返回false，并设置监听事件
+ */
+bool kmsg_queue_pop_all(kmsg_queue_t *kmsg_q, fifo_t *out, kevent_t *listen_ev);
+
+/*
+ * 在一次临界区中取出消息队列头部最多max_nums个消息，并转移至out的尾部
+ * 传入一个监听事件，返回取出的消息个数。若队列为空返回0，并设置监听事件
+ */
+uint32_t kmsg_queue_pop_n(kmsg_queue_t *kmsg_q, fifo_t *out, uint32_t max_nums, kevent_t *listen_ev);
+
+/*********************************************
+ *@简要：初始化一个消息队列多路等待
+ *
+ *@参数：
+ *[select]    多路等待
+ *[entries]   可容纳nums个元素的数组
+ *[kmsg_qs]   被等待的消息队列
+ *[nums]      被等待的消息队列个数
+ *[listen_ev] 任意消息队列非空时触发的监听事件
+ *********************************************
+ */
+void kmsg_select_init(kmsg_select_t *select, kmsg_select_entry_t *entries,
+                      kmsg_queue_t *const *kmsg_qs, uint8_t nums, kevent_t *listen_ev);
+
+/*
+ * 等待多个消息队列中的任意一个非空
+ * 若存在非空的消息队列，返回其序号。若所有队列为空返回-1，并在所有队列上设置监听，
+ * 第一个消息到达时，监听事件仅被触发一次，同时撤销在其他队列上的监听，
+ * 通过kmsg_select_ready获取就绪的消息队列序号
+ */
+int kmsg_select(kmsg_select_t *select);
+
+/* 获取已就绪的消息队列序号，-1表示无就绪的消息队列 */
+static force_inline int kmsg_select_ready(kmsg_select_t *select)
+{
+    return select->ready;
+}
+
+/* 获取序号对应的消息队列 */
+static force_inline kmsg_queue_t *kmsg_select_queue(kmsg_select_t *select, int idx)
+{
+    return select->entries[idx].kmsg_q;
+}
+
+/* 撤销在所有消息队列上的监听 */
+void kmsg_select_cancel(kmsg_select_t *select);
+
 #endif /* __OS_MSG_QUEUE_H__ */
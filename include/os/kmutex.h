@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KMUTEX_H__
+#define __OS_KMUTEX_H__
+
+#include <os/kevent.h>
+#include <bp.h>
+
+typedef struct kmutex_s {
+    /* 等待事件，按优先级排序，相同优先级按先进先出排序 */
+    kevent_queue_t wait_q;
+
+    /* 持有者事件，为NULL时表示互斥锁未被持有 */
+    kevent_t *owner;
+
+    /* 持有者获取互斥锁时的优先级，优先级继承结束后恢复 */
+    uint8_t owner_priority;
+
+    /* 互斥锁标志，KMUTEX_FLAG_* */
+    uint8_t flags;
+} kmutex_t;
+
+/* 优先级继承，持有者的优先级将被提升至最高优先级的等待事件
+ * 继承只作用于就绪或正在运行的持有者：持有者的事件处于其他等待队列（信号量、消息队列、
+ * 其他互斥锁等）之中时保持原优先级，直到该互斥锁下一次加锁、取消或释放时重新计算 */
+#define KMUTEX_FLAG_INHERIT     BIT(0)
+
+/* 优先级继承可提升到的最高优先级，立即事件的提交语义不同，不参与继承 */
+#define KMUTEX_INHERIT_PRIORITY_MAX     (KEVENT_PRIORITY_IMMED - 1)
+
+#define KMUTEX_STATIC_INIT(mutex, flags)    \
+{                                           \
+    KEVENT_QUEUE_STATIC_INIT((mutex).wait_q),   \
+    NULL, 0, (flags)                        \
+}
+
+#define KMUTEX_DEFINE(_name, flags)         \
+    kmutex_t _name = KMUTEX_STATIC_INIT(_name, flags)
+
+#define KMUTEX_DEFINE_STATIC(_name, flags)  \
+    static kmutex_t _name = KMUTEX_STATIC_INIT(_name, flags)
+
+static inline void kmutex_init(kmutex_t *mutex, uint8_t flags)
+{
+    kevent_queue_init(&mutex->wait_q);
+    mutex->owner = NULL;
+    mutex->owner_priority = 0;
+    mutex->flags = flags;
+}
+
+/* 互斥锁是否被持有 */
+static force_inline bool kmutex_is_locked(kmutex_t *mutex)
+{
+    return mutex->owner != NULL;
+}
+
+/* 获取互斥锁的持有者事件 */
+static force_inline kevent_t *kmutex_owner_get(kmutex_t *mutex)
+{
+    return mutex->owner;
+}
+
+/*
+ * 获取互斥锁，ev作为持有者的标识，协程应当传入其任务事件
+ * 若互斥锁空闲返回true。否则返回false，ev按优先级排队，
+ * 互斥锁被释放时，ev成为新的持有者并被触发
+ * 若开启了优先级继承，持有者的优先级将被提升至ev的优先级
+ * ev已经是持有者时直接返回true，互斥锁不计数，一次kmutex_unlock即释放
+ */
+bool kmutex_lock(kmutex_t *mutex, kevent_t *ev);
+
+/*
+ * 取消kmutex_lock的等待，返回false表示ev已经获得了互斥锁
+ * ev只能处于该互斥锁的等待队列之中或不处于任何队列，
+ * 使用双向链表节点时不检查ev所在的队列，处于其他队列的ev也会被移除
+ */
+bool kmutex_lock_cancel(kmutex_t *mutex, kevent_t *ev);
+
+/*
+ * 释放互斥锁，只能由持有者调用，互斥锁未被持有时不做任何操作
+ * 持有者的优先级被恢复，最高优先级的等待事件成为新的持有者并被触发
+ * 持有者应当在进入其他等待队列之前释放互斥锁，否则其被提升的优先级无法恢复
+ */
+void kmutex_unlock(kmutex_t *mutex);
+
+/*********************************************************
+ *@简要：
+ ***在bpd协程中获取互斥锁，互斥锁被持有时让出执行，获得互斥锁后恢复执行
+ *
+ *@参数：
+ *[bp_num]：用于恢复执行的，bpd断点号
+ *[mutex]：互斥锁
+ *[ev]：被触发以恢复协程的事件，ktask_co应当传入&task->event
+ **********************************************************/
+#define kmutex_bpd_lock(bp_num, mutex, ev)          \
+    do {                                            \
+        if (!kmutex_lock((mutex), (ev))) {          \
+            bpd_yield(bp_num);                      \
+        }                                           \
+    } while (0)
+
+#endif /* __OS_KMUTEX_H__ */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2018-2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KRING_QUEUE_H__
+#define __OS_KRING_QUEUE_H__
+
+#include <os/kevent.h>
+
+/* KRING_QUEUE错误断言 */
+#ifndef KRING_QUEUE_ASSERT
+#define KRING_QUEUE_ASSERT(expr)
+#endif /* KRING_QUEUE_ASSERT */
+
+/* 读写位置的取值范围为[0, 2 * msg_nums)，需在uint16_t与int16_t中表示 */
+#define KRING_QUEUE_MSG_NUMS_MAX    0x3FFF
+
+/* 静态初始化时检查消息条数，超出KRING_QUEUE_MSG_NUMS_MAX时编译失败 */
+#define KRING_QUEUE_MSG_NUMS_CHECK(msg_nums)    \
+    ((msg_nums) + 0 * sizeof(char[(msg_nums) <= KRING_QUEUE_MSG_NUMS_MAX ? 1 : -1]))
+
+/* 环形消息队列，消息以值拷贝的方式进出队列，适用于小而固定大小的消息 */
+typedef struct kring_queue_s {
+    /* 消息缓冲区 */
+    uint8_t *buff;
+
+    /* 每条消息的大小 */
+    uint16_t msg_size;
+
+    /* 队列可容纳的消息条数，不超过KRING_QUEUE_MSG_NUMS_MAX */
+    uint16_t msg_nums;
+
+    /* 写入位置与读取位置，取值范围为[0, 2 * msg_nums)，以区分队列满与空 */
+    volatile uint16_t head;
+    volatile uint16_t tail;
+
+    /* 队列中曾经达到的最大消息条数 */
+    uint16_t high_water;
+
+    /* 监听事件，通常只有一个处理者 */
+    kevent_queue_t wait_q;
+} kring_queue_t;
+
+#define KRING_QUEUE_STATIC_INIT(kring_q, buff, msg_size, msg_nums)  \
+{                                                                   \
+    (uint8_t *)(buff), (msg_size),                                  \
+    KRING_QUEUE_MSG_NUMS_CHECK(msg_nums), 0, 0, 0,                  \
+    KEVENT_QUEUE_STATIC_INIT((kring_q).wait_q)                      \
+}
+
+/************************************************************
+ *@简介：
+ ***定义一个环形消息队列及其缓冲区
+ *
+ *@参数：
+ *[_name]：环形消息队列的名字
+ *[type]：消息的类型
+ *[count]：队列可容纳的消息条数，不超过KRING_QUEUE_MSG_NUMS_MAX
+ *************************************************************/
+#define KRING_QUEUE_DEFINE(_name, type, count)                                  \
+    type _name##_ring_buf[(count)];                                             \
+    kring_queue_t _name = KRING_QUEUE_STATIC_INIT(_name, _name##_ring_buf,      \
+                                                  sizeof(type), (count))
+
+/************************************************************
+ *@简介：
+ ***使用static修饰定义一个环形消息队列及其缓冲区
+ *
+ *@参数：
+ *[_name]：环形消息队列的名字
+ *[type]：消息的类型
+ *[count]：队列可容纳的消息条数，不超过KRING_QUEUE_MSG_NUMS_MAX
+ *************************************************************/
+#define KRING_QUEUE_DEFINE_STATIC(_name, type, count)                           \
+    static type _name##_ring_buf[(count)];                                      \
+    static kring_queue_t _name = KRING_QUEUE_STATIC_INIT(_name, _name##_ring_buf,\
+                                                         sizeof(type), (count))
+
+/*********************************************
+ *@简要：使用buffer初始化一个环形消息队列
+ *
+ *@参数：
+ *[kring_q]  环形消息队列
+ *[buff]     消息缓冲区，大小为msg_size * msg_nums
+ *[msg_size] 每条消息的大小
+ *[msg_nums] 队列可容纳的消息条数，不超过KRING_QUEUE_MSG_NUMS_MAX
+ *********************************************
+ */
+static inline void kring_queue_init(kring_queue_t *kring_q, void *buff, uint16_t msg_size, uint16_t msg_nums)
+{
+    KRING_QUEUE_ASSERT(msg_nums <= KRING_QUEUE_MSG_NUMS_MAX);
+
+    kring_q->buff = (uint8_t *)buff;
+    kring_q->msg_size = msg_size;
+    kring_q->msg_nums = msg_nums;
+    kring_q->head = 0;
+    kring_q->tail = 0;
+    kring_q->high_water = 0;
+    kevent_queue_init(&kring_q->wait_q);
+}
+
+/* 获取队列中的消息条数 */
+static force_inline uint16_t kring_queue_count(kring_queue_t *kring_q)
+{
+    int16_t count = kring_q->head - kring_q->tail;
+
+    return count < 0 ? count + 2 * kring_q->msg_nums : count;
+}
+
+/* 获取队列中曾经达到的最大消息条数 */
+static force_inline uint16_t kring_queue_high_water_get(kring_queue_t *kring_q)
+{
+    return kring_q->high_water;
+}
+
+/*
+ * 将消息拷贝至环形消息队列
+ * 若队列已满返回false，若队列存在监听事件，该操作结束后将触发监听事件
+ * 该操作可以在任意上下文中被多个生产者调用
+ */
+bool kring_queue_push(kring_queue_t *kring_q, const void *msg);
+
+/*
+ * 从环形消息队列中取出消息，并拷贝至msg
+ * 传入一个监听事件，若队列非空返回true。若队列为空返回false，并设置监听事件
+ */
+bool kring_queue_pop(kring_queue_t *kring_q, void *msg, kevent_t *listen_ev);
+
+/*
+ * 单生产者的无锁入队操作，通常用于中断向事件传递消息
+ *
+ *@约定：
+ ***1、同一时刻只能有一个生产者使用该操作，且不能与kring_queue_push混用
+ ***2、生产者的执行优先级需高于消费者(如中断)，即生产者不会被消费者打断
+ */
+bool kring_queue_spsc_push(kring_queue_t *kring_q, const void *msg);
+
+/*
+ * 单消费者的无锁出队操作，与kring_queue_spsc_push配合使用
+ * 仅在队列为空需要设置监听事件时才会关闭中断
+ *
+ *@约定：
+ ***1、同一时刻只能有一个消费者使用该操作，且不能与kring_queue_pop混用
+ */
+bool kring_queue_spsc_pop(kring_queue_t *kring_q, void *msg, kevent_t *listen_ev);
+
+#endif /* __OS_KRING_QUEUE_H__ */
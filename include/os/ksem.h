@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KSEM_H__
+#define __OS_KSEM_H__
+
+#include <os/kevent.h>
+#include <bp.h>
+
+typedef struct ksem_s {
+    /* 等待事件，按优先级排序，相同优先级按先进先出排序 */
+    kevent_queue_t wait_q;
+
+    /* 可用的信号量个数 */
+    uint16_t count;
+
+    /* 信号量个数的上限，为0时表示不限制 */
+    uint16_t limit;
+} ksem_t;
+
+#define KSEM_STATIC_INIT(sem, count, limit) \
+{                                           \
+    KEVENT_QUEUE_STATIC_INIT((sem).wait_q), \
+    (count), (limit)                        \
+}
+
+#define KSEM_DEFINE(_name, count, limit)    \
+    ksem_t _name = KSEM_STATIC_INIT(_name, count, limit)
+
+#define KSEM_DEFINE_STATIC(_name, count, limit) \
+    static ksem_t _name = KSEM_STATIC_INIT(_name, count, limit)
+
+static inline void ksem_init(ksem_t *sem, uint16_t count, uint16_t limit)
+{
+    kevent_queue_init(&sem->wait_q);
+    sem->count = count;
+    sem->limit = limit;
+}
+
+/* 获取可用的信号量个数 */
+static force_inline uint16_t ksem_count_get(ksem_t *sem)
+{
+    return sem->count;
+}
+
+/*
+ * 获取一个信号量
+ * 若存在可用的信号量返回true。否则返回false，ev按优先级排队，
+ * 信号量被释放时直接交给ev，并触发ev
+ */
+bool ksem_take(ksem_t *sem, kevent_t *ev);
+
+/*
+ * 取消ksem_take的等待，返回false表示ev已经获得了信号量
+ * ev只能处于该信号量的等待队列之中或不处于任何队列，
+ * 使用双向链表节点时不检查ev所在的队列，处于其他队列的ev也会被移除
+ */
+bool ksem_take_cancel(ksem_t *sem, kevent_t *ev);
+
+/*
+ * 释放一个信号量，若存在等待事件，信号量直接交给最高优先级的等待事件并触发它
+ * 信号量个数达到上限时返回false
+ */
+bool ksem_give(ksem_t *sem);
+
+/*********************************************************
+ *@简要：
+ ***在bpd协程中获取信号量，无可用信号量时让出执行，获得信号量后恢复执行
+ *
+ *@参数：
+ *[bp_num]：用于恢复执行的，bpd断点号
+ *[sem]：信号量
+ *[ev]：被触发以恢复协程的事件，ktask_co应当传入&task->event
+ **********************************************************/
+#define ksem_bpd_take(bp_num, sem, ev)              \
+    do {                                            \
+        if (!ksem_take((sem), (ev))) {              \
+            bpd_yield(bp_num);                      \
+        }                                           \
+    } while (0)
+
+#endif /* __OS_KSEM_H__ */
@@ -6,9 +6,26 @@
 #define __OS_KTASK_CO_H__
 
 #include <os/kevent.h>
+#include <os/ktimer.h>
+#include <os/slab_mem.h>
 #include <arch/irq.h>
 #include <bp.h>
 
+/* 异步栈监视，记录每个任务异步栈使用深度的峰值并检测栈溢出，用于调试与调整栈大小，默认关闭 */
+#ifndef KTASK_CO_STACK_MONITOR
+#define KTASK_CO_STACK_MONITOR  0
+#endif
+
+/* 写在异步栈末尾的金丝雀值 */
+#define KTASK_CO_STACK_CANARY   0xC0DEC0DEUL
+
+#if KTASK_CO_STACK_MONITOR
+/* 金丝雀占用的空间，位于stack.end处 */
+#define KTASK_CO_STACK_CANARY_SIZE  CPU_WORD_SIZE
+#else
+#define KTASK_CO_STACK_CANARY_SIZE  0
+#endif
+
 /*********************************************************
  *@类型说明：
  *
@@ -30,6 +47,15 @@ struct ktask_co_stack_s
     uint8_t *cur;
 };
 
+/* 异步栈监视信息 */
+struct ktask_co_stack_monitor_s
+{
+    slist_node_t node;
+    uint32_t peak;
+    uint32_t seg_used;
+    bool overflow;
+};
+
 /* ktask_co协程任务 */
 typedef struct ktask_co_s
 {
@@ -42,9 +68,33 @@ typedef struct ktask_co_s
         int32_t  s32;
     } ret_val;
 
-    lifo_t task_end_notify_q;
+    kevent_queue_t task_end_notify_q;
+
+    /* 协程睡眠使用的定时器 */
+    ktimer_event_t sleep_timer;
+
+    /* 分段异步栈的段分配器，为NULL时使用连续的异步栈 */
+    kslab_mem_t *seg_pool;
+
+    /* 最近一次异步调用因段分配器耗尽而未执行 */
+    bool asyn_call_failed;
+
+#if KTASK_CO_STACK_MONITOR
+    struct ktask_co_stack_monitor_s monitor;
+#endif
 } ktask_co_t;
 
+/* 分段异步栈的段头部，记录上一个段的栈指针信息 */
+struct ktask_co_seg_s
+{
+    uint8_t *prev_start;
+    uint8_t *prev_end;
+    uint8_t *prev_cur;
+};
+
+/* 段头部的大小 */
+#define KTASK_CO_SEG_HDR_SIZE   ALIGN_CPU_UP(sizeof(struct ktask_co_seg_s))
+
 /* KTASK_CO错误断言 */
 #ifndef KTASK_CO_ASSERT
 #define KTASK_CO_ASSERT(expr)
@@ -55,6 +105,80 @@ typedef struct ktask_co_s
 #define KTASK_CO_INFO(task, stack_size, stack_used)
 #endif /* TASK_INFO */
 
+/* KTASK_CO异步栈溢出，金丝雀被破坏或栈使用超出范围时调用 */
+#ifndef KTASK_CO_STACK_OVERFLOW
+#define KTASK_CO_STACK_OVERFLOW(task)   KTASK_CO_ASSERT(0)
+#endif /* KTASK_CO_STACK_OVERFLOW */
+
+/*********************************************************
+ *@类型说明：
+ *
+ *[ktask_co_stack_info_t]：任务异步栈的使用情况
+ *********************************************************/
+typedef struct ktask_co_stack_info_s
+{
+    struct ktask_co_s *task;
+
+    /* 连续异步栈的可用大小，分段异步栈为单个段的可用大小 */
+    uint32_t size;
+
+    /* 异步栈使用深度的峰值 */
+    uint32_t peak;
+
+    /* 异步栈当前的使用深度 */
+    uint32_t depth;
+
+    /* 是否检测到异步栈溢出 */
+    bool overflow;
+} ktask_co_stack_info_t;
+
+/* 异步栈报告的回调函数类型 */
+typedef void (*ktask_co_stack_report_cb)(const ktask_co_stack_info_t *info, void *arg);
+
+/*********************************************************
+ *@类型说明：
+ *
+ *[ktask_co_join_cancel_cb]：取消一个未完成的子操作
+ *[ktask_co_join_entry_t]：一个子操作，其事件在子操作完成时被触发
+ *[ktask_co_join_t]：等待一组子操作全部完成或任意一个完成
+ *********************************************************/
+typedef void (*ktask_co_join_cancel_cb)(kevent_t *ev, void *arg);
+
+typedef struct ktask_co_join_entry_s
+{
+    kevent_t event;
+    struct ktask_co_join_s *join;
+    ktask_co_join_cancel_cb cancel;
+    void *cancel_arg;
+} ktask_co_join_entry_t;
+
+typedef struct ktask_co_join_s
+{
+    struct ktask_co_s *task;
+    ktask_co_join_entry_t *entries;
+
+    /* 已完成的子操作位图 */
+    uint32_t done;
+    uint8_t nums;
+    uint8_t pending;
+    uint8_t mode;
+
+    /* 父协程是否正在等待 */
+    uint8_t waiting;
+
+    /* 第一个完成的子操作序号，-1表示尚无子操作完成 */
+    int8_t first;
+} ktask_co_join_t;
+
+/* 等待所有子操作完成 */
+#define KTASK_CO_JOIN_ALL   0
+
+/* 等待任意一个子操作完成，并取消其他子操作 */
+#define KTASK_CO_JOIN_ANY   1
+
+/* 一组子操作的最大个数 */
+#define KTASK_CO_JOIN_NUMS_MAX  32
+
 /*********************************************************
  *@类型说明：
  *
@@ -62,9 +186,18 @@ typedef struct ktask_co_s
  *********************************************************/
 typedef void (*ktask_co_asyn_routine_t)(struct ktask_co_s *, kevent_t *);
 
+/* 睡眠定时器的回调，恢复协程的执行，不应该被直接使用 */
+void ktask_co_sleep_timer_cb(void *data, kevent_t *ev);
+
 /* KTASK_CO的bpd指针，由bpd协程使用 */
 #define KTASK_CO_BPD(task)  (&((ktask_co_t *)(task))->cur_ctx.bp)
 
+#if KTASK_CO_STACK_MONITOR
+#define _KTASK_CO_MONITOR_STATIC_INIT(task)  , {SLIST_NODE_STATIC_INIT((task).monitor.node), 0, 0, false}
+#else
+#define _KTASK_CO_MONITOR_STATIC_INIT(task)
+#endif
+
 /************************************************************
  *@简介：
  ***任务数据结构静态初始化
@@ -78,15 +211,45 @@ typedef void (*ktask_co_asyn_routine_t)(struct ktask_co_s *, kevent_t *);
  *************************************************************/
 #define KTASK_CO_STATIC_INIT(task, stack, stack_size, priority)                 \
 {                                                                               \
-    KEVENT_STATIC_INIT((task).event, (event_cb)NULL_CB, &task, (priority)),     \
+    KEVENT_STATIC_INIT((task).event, (kevent_cb)0, &task, (priority)),         \
     {                                                                           \
-        (stack),                                                                \
-        (uint8_t *)(stack) + (stack_size),                                      \
-        (stack),                                                                \
+        (uint8_t *)(stack),                                                     \
+        (uint8_t *)(stack) + (stack_size) - KTASK_CO_STACK_CANARY_SIZE,         \
+        (uint8_t *)(stack),                                                     \
     },                                                                          \
-    {0, 0, BP_INIT_VAL},                                                        \
+    {0, BP_INIT_VAL, 0},                                                        \
     {0},                                                                        \
-    LIFO_STATIC_INIT((task).task_end_notify_q)                                  \
+    KEVENT_QUEUE_STATIC_INIT((task).task_end_notify_q),                         \
+    KTIMER_EVENT_STATIC_INIT((task).sleep_timer, ktask_co_sleep_timer_cb,       \
+                             &task, (priority)),                                \
+    NULL,                                                                       \
+    false                                                                       \
+    _KTASK_CO_MONITOR_STATIC_INIT(task)                                         \
+}
+
+
+/************************************************************
+ *@简介：
+ ***使用分段异步栈的任务数据结构静态初始化，
+ ***异步栈按需从seg_pool中分配固定大小的段，并在异步返回时归还
+ *
+ *@参数：
+ *[task]：任务的变量名，非指针
+ *[seg_pool]：段分配器，所有任务可共享同一个段分配器
+ *[priority]：任务事件的优先级
+ *************************************************************/
+#define KTASK_CO_SEG_STATIC_INIT(task, seg_pool, priority)                     \
+{                                                                               \
+    KEVENT_STATIC_INIT((task).event, (kevent_cb)0, &task, (priority)),         \
+    {NULL, NULL, NULL},                                                         \
+    {0, BP_INIT_VAL, 0},                                                        \
+    {0},                                                                        \
+    KEVENT_QUEUE_STATIC_INIT((task).task_end_notify_q),                         \
+    KTIMER_EVENT_STATIC_INIT((task).sleep_timer, ktask_co_sleep_timer_cb,       \
+                             &task, (priority)),                                \
+    (seg_pool),                                                                 \
+    false                                                                       \
+    _KTASK_CO_MONITOR_STATIC_INIT(task)                                         \
 }
 
 
@@ -102,7 +265,7 @@ typedef void (*ktask_co_asyn_routine_t)(struct ktask_co_s *, kevent_t *);
  *************************************************************/
 #define KTASK_CO_DEFINE(_name, stack_size, priority)                \
     uint32_t _name##_stack_buf[(stack_size + 3) / 4];               \
-    ktask_co_t  _name = TASK_STATIC_INIT(_name,                     \
+    ktask_co_t  _name = KTASK_CO_STATIC_INIT(_name,                 \
                                      _name##_stack_buf,             \
                                      (stack_size),                  \
                                      (priority))
@@ -120,13 +283,38 @@ typedef void (*ktask_co_asyn_routine_t)(struct ktask_co_s *, kevent_t *);
  *************************************************************/
 #define KTASK_CO_DEFINE_STATIC(_name, stack_size, priority)         \
     static uint32_t _name##_stack_buf[(stack_size + 3) / 4];        \
-    static ktask_co_t  _name = TASK_STATIC_INIT(_name,              \
+    static ktask_co_t  _name = KTASK_CO_STATIC_INIT(_name,          \
                                             _name##_stack_buf,      \
                                             (stack_size),           \
                                             (priority))
 
+/************************************************************
+ *@简介：
+ ***定义一个使用分段异步栈的任务对象，并初始化
+ *
+ *@参数：
+ *[_name]：任务对象的名字
+ *[seg_pool]：段分配器的指针
+ *[priority]：任务事件的优先级
+ *************************************************************/
+#define KTASK_CO_SEG_DEFINE(_name, seg_pool, priority)              \
+    ktask_co_t  _name = KTASK_CO_SEG_STATIC_INIT(_name, (seg_pool), (priority))
+
+
+/************************************************************
+ *@简介：
+ ***使用static修饰定义一个使用分段异步栈的任务对象，并初始化
+ *
+ *@参数：
+ *[_name]：任务对象的名字
+ *[seg_pool]：段分配器的指针
+ *[priority]：任务事件的优先级
+ *************************************************************/
+#define KTASK_CO_SEG_DEFINE_STATIC(_name, seg_pool, priority)       \
+    static ktask_co_t  _name = KTASK_CO_SEG_STATIC_INIT(_name, (seg_pool), (priority))
+
 /* 进行异步调用时需要保存的任务上下文信息大小 */
-#define KTASK_CO_STACK_CTX_SIZE    (sizeof(struct ktask_co_cur_ctx_s) + sizeof(kevent_cb))
+#define KTASK_CO_STACK_CTX_SIZE    ALIGN_CPU_UP(sizeof(struct ktask_co_cur_ctx_s) + sizeof(kevent_cb))
 
 /* 简单的宏，返回a - b保证大于等于0 */
 #define _SUB_BEZ(a, b)  ((a) > (b) ? ((a) - (b)) : 0)
@@ -145,6 +333,119 @@ typedef void (*ktask_co_asyn_routine_t)(struct ktask_co_s *, kevent_t *);
 void ktask_co_init(ktask_co_t *task, void *stack, size_t stack_size, uint8_t priority);
 
 
+/************************************************************
+ *@简介：
+ ***使用分段异步栈的任务数据结构动态初始化
+ ***
+ ***异步栈按需从seg_pool中分配固定大小的段，并在异步返回时归还，
+ ***因此内存占用取决于所有任务实际的调用深度，而不是每个任务最坏情况的深度。
+ ***单个异步函数的异步变量与上下文信息必须能够放入一个段中
+ *
+ *@参数：
+ *[task]：任务对象
+ *[seg_pool]：段分配器，所有任务可共享同一个段分配器
+ *[priority]：任务事件的优先级
+ *************************************************************/
+void ktask_co_init_seg(ktask_co_t *task, kslab_mem_t *seg_pool, uint8_t priority);
+
+
+/************************************************************
+ *@简介：
+ ***为分段异步栈分配一个新的段，由异步栈空间不足时使用，不应该被直接使用
+ *
+ *@参数：
+ *[task]：任务对象
+ *
+ *@返回值：
+ *[true]：分配成功
+ *[false]：段分配器已耗尽，任务的异步栈保持不变
+ *************************************************************/
+bool ktask_co_seg_push(ktask_co_t *task);
+
+
+#if KTASK_CO_STACK_MONITOR
+/************************************************************
+ *@简介：
+ ***将任务加入异步栈监视列表，并在连续异步栈的末尾写入金丝雀，
+ ***由ktask_co_init与task_start调用，重复调用是安全的
+ *
+ *@参数：
+ *[task]：任务对象
+ *************************************************************/
+void ktask_co_stack_monitor_register(ktask_co_t *task);
+
+/************************************************************
+ *@简介：
+ ***将任务从异步栈监视列表中移除，由任务结束时调用，
+ ***释放仍在运行的任务之前也需要调用，重复调用是安全的
+ *
+ *@参数：
+ *[task]：任务对象
+ *************************************************************/
+void ktask_co_stack_monitor_unregister(ktask_co_t *task);
+
+#define _ktask_co_stack_monitor_register(task)      ktask_co_stack_monitor_register(task)
+#define _ktask_co_stack_monitor_unregister(task)    ktask_co_stack_monitor_unregister(task)
+#else
+#define _ktask_co_stack_monitor_register(task)      ((void)0)
+#define _ktask_co_stack_monitor_unregister(task)    ((void)0)
+#endif
+
+
+/************************************************************
+ *@简介：
+ ***获取任务异步栈的使用情况，KTASK_CO_STACK_MONITOR为0时峰值与溢出标志无效
+ *
+ *@参数：
+ *[task]：任务对象
+ *[info]：输出的异步栈使用情况
+ *************************************************************/
+void ktask_co_stack_info_get(ktask_co_t *task, ktask_co_stack_info_t *info);
+
+
+/************************************************************
+ *@简介：
+ ***遍历所有已注册的任务，报告各任务异步栈的大小、峰值与当前深度，
+ ***可据此安全地缩小任务的异步栈；已结束的任务不在列表中，需要在任务运行期间报告
+ *
+ *@参数：
+ *[report]：每个任务调用一次的报告回调，在中断开启的状态下调用
+ *[arg]：传递给报告回调的参数
+ *************************************************************/
+void ktask_co_stack_report(ktask_co_stack_report_cb report, void *arg);
+
+
+/*********************************************************
+ *@简要：
+ ***检查异步栈的金丝雀与使用范围，并更新异步栈使用深度的峰值，
+ ***由异步栈分配时使用，不应该被直接使用
+ *
+ *@参数：
+ *[task]：任务对象
+ *[top]：本次分配后异步栈的栈顶
+ **********************************************************/
+static force_inline void ktask_co_stack_track(ktask_co_t *task, uint8_t *top)
+{
+#if KTASK_CO_STACK_MONITOR
+    uint32_t depth;
+
+    if (top > task->stack.end ||
+        *(uint32_t *)task->stack.end != (uint32_t)KTASK_CO_STACK_CANARY) {
+        task->monitor.overflow = true;
+        KTASK_CO_STACK_OVERFLOW(task);
+    }
+
+    depth = task->monitor.seg_used + (uint32_t)(top - task->stack.start);
+    if (depth > task->monitor.peak) {
+        task->monitor.peak = depth;
+    }
+#else
+    (void)task;
+    (void)top;
+#endif
+}
+
+
 /************************************************************
  *@简要：
  ***将一个事件初始化为协程的异步事件
@@ -167,7 +468,8 @@ void ktask_co_init(ktask_co_t *task, void *stack, size_t stack_size, uint8_t pri
  *************************************************************/
 #define task_start(task, task_func, ...)                        \
     do {                                                        \
-        KEVENT_CALLBACK(&(task)->event) = (event_cb)(task_func);\
+        _ktask_co_stack_monitor_register(task);                 \
+        KEVENT_CALLBACK(&(task)->event) = (kevent_cb)(task_func);\
         (task_func)((task), NULL, ##__VA_ARGS__);               \
     } while (0)
 
@@ -186,7 +488,8 @@ void ktask_co_init(ktask_co_t *task, void *stack, size_t stack_size, uint8_t pri
  *[task]：任务对象
  *[vars_size]：异步变量的大小
  *
- *@返回：异步变量的内存地址
+ *@返回：异步变量的内存地址，分段异步栈的段分配器耗尽时返回NULL，
+ ***此时异步函数应当使用ktask_co_asyn_return返回调用者
  **********************************************************/
 static inline void *ktask_co_asyn_vars_get(ktask_co_t *task, size_t vars_size)
 {
@@ -195,8 +498,16 @@ static inline void *ktask_co_asyn_vars_get(ktask_co_t *task, size_t vars_size)
     if (task->cur_ctx.bp == 0) {
         alloc_size = ALIGN_CPU_UP(vars_size);
 
+        /* 分段异步栈在当前段中为异步变量和下一次异步调用的上下文预留空间，不足时分配新的段 */
+        if (task->seg_pool &&
+            (size_t)(task->stack.end - task->stack.cur) < alloc_size + KTASK_CO_STACK_CTX_SIZE &&
+            !ktask_co_seg_push(task)) {
+            return NULL;
+        }
+
         KTASK_CO_INFO((task), (task->stack.end - task->stack.start), (task->stack.cur + alloc_size - task->stack.start));
         KTASK_CO_ASSERT(task->stack.cur + alloc_size <= task->stack.end);
+        ktask_co_stack_track(task, task->stack.cur + alloc_size);
 
         task->cur_ctx.stack_used = alloc_size;
     }
@@ -252,11 +563,12 @@ static inline void ktask_co_end_wait(ktask_co_t *task, kevent_t *task_end_notify
 {
     int key = irq_lock();
 
-    if (!slist_node_is_del(KEVENT_NODE(task_end_notify_ev))) {
+    if (!kevent_node_is_del(KEVENT_NODE(task_end_notify_ev))) {
         irq_unlock(key);
+        return;
     }
 
-    lifo_push(&task->task_end_notify_q, KEVENT_NODE(task_end_notify_ev));
+    kevent_queue_push(&task->task_end_notify_q, KEVENT_NODE(task_end_notify_ev));
     irq_unlock(key);
 }
 
@@ -276,6 +588,26 @@ static inline void ktask_co_end_wait(ktask_co_t *task, kevent_t *task_end_notify
 bool ktask_end_wait_cancel(ktask_co_t *task, kevent_t *task_end_notify_ev);
 
 
+/*********************************************************
+ *@简要：
+ ***终止一个未结束的任务：撤销任务已就绪的事件与睡眠定时器，归还异步栈，
+ ***并如同任务正常结束一样通知等待任务结束的事件
+ *
+ *@约定：
+ ***1、不能在可能抢占该任务的上下文中调用，即任务的回调不能正处于执行之中
+ ***2、任务的事件处于其他等待队列（如信号量、消息队列、其他任务的结束通知）时无法撤销，
+ ***   此时不终止任务；以ktask_co_event_inherit创建的事件需要由调用者自行撤销
+ *
+ *@参数：
+ *[task]：任务对象
+ *
+ *@返回值：
+ *[true]：任务已终止或已经结束
+ *[false]：任务正在等待其他队列，未被终止
+ **********************************************************/
+bool ktask_co_abort(ktask_co_t *task);
+
+
 /************************************************************
  *@简介：
  ***将当前上下文保存到栈中，并初始化新的上下文信息
@@ -285,8 +617,19 @@ bool ktask_end_wait_cancel(ktask_co_t *task, kevent_t *task_end_notify_ev);
  *@参数：
  *[task]：任务对象
  *[afunc]：被调用的异步函数
+ *
+ *@返回值：
+ *[true]：上下文已保存，可以调用afunc
+ *[false]：段分配器已耗尽，无法保存上下文，任务保持不变
  *************************************************************/
-void ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc, void **pbpd);
+bool ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc, void **pbpd);
+
+
+/* 判断最近一次ktask_co_bpd_asyn_call是否因段分配器耗尽而未执行被调用的异步函数 */
+static force_inline bool ktask_co_asyn_call_failed(ktask_co_t *task)
+{
+    return task->asyn_call_failed;
+}
 
 
 /*********************************************************
@@ -294,7 +637,9 @@ void ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc,
  ***异步地调用异步函数，并等待异步函数使用ktask_co_asyn_return返回
  *
  *@约定：
- ***不能使用空指针
+ ***1、不能使用空指针
+ ***2、分段异步栈的段分配器耗尽时不执行afunc，调用立即结束，
+ ***   调用者可以使用ktask_co_asyn_call_failed判断，不会阻塞等待段分配器
  *
  *@参数：
  *[bp_num]：用于异步返回的，bpd断点号
@@ -305,15 +650,185 @@ void ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc,
 #define ktask_co_bpd_asyn_call(bp_num, task, afunc, ...)                                \
     do {                                                                                \
         bpd_set(bp_num);                                                                \
-        ktask_co_asyn_call_prepare((task), (ktask_co_asyn_routine_t)afunc, (void **)&(bpd)); \
-        afunc((task), (event_t *)NULL, ##__VA_ARGS__);                                  \
+        if (!ktask_co_asyn_call_prepare((task), (ktask_co_asyn_routine_t)afunc,         \
+                                        (void **)&(bpd))) {                             \
+            break;                                                                      \
+        }                                                                               \
+        afunc((task), (kevent_t *)NULL, ##__VA_ARGS__);                                 \
         if ((uint8_t *)(bpd) != (task->stack.cur + task->cur_ctx.stack_used)) {         \
             *(uint8_t *)(bpd) = 1;                                                      \
             return ;                                                                    \
         }                                                                               \
-        (bpd) = KTASK_BPD(task);                                                        \
+        (bpd) = KTASK_CO_BPD(task);                                                     \
         bpd_restore_point(bp_num):;                                                     \
     } while (0)
 
 
+/*********************************************************
+ *@简要：
+ ***协程睡眠至expiry时刻，使用任务内嵌的定时器，无需额外的定时器对象
+ ***
+ ***以ktask_co_sleep_expiry_get获取的上一次到期时刻加上周期作为expiry，
+ ***可实现无漂移的周期执行
+ *
+ *@约定：
+ ***1、不能使用空指针
+ ***2、同一时刻一个任务只能有一个睡眠
+ *
+ *@参数：
+ *[bp_num]：用于恢复执行的，bpd断点号
+ *[task]：任务对象
+ *[expiry]：到期时刻
+ **********************************************************/
+#define ktask_co_bpd_sleep_until(bp_num, task, expiry)                                  \
+    do {                                                                                \
+        ktimer_start_expiry(&(task)->sleep_timer, (expiry));                            \
+        bpd_yield(bp_num);                                                              \
+    } while (0)
+
+
+/* 协程睡眠timeout_ms毫秒 */
+#define ktask_co_bpd_sleep_ms(bp_num, task, timeout_ms)                                 \
+    ktask_co_bpd_sleep_until(bp_num, task, ktime_tick_get() + ktime_ms_to_tick(timeout_ms))
+
+
+/* 协程睡眠timeout_us微秒 */
+#define ktask_co_bpd_sleep_us(bp_num, task, timeout_us)                                 \
+    ktask_co_bpd_sleep_until(bp_num, task, ktime_tick_get() + ktime_us_to_tick(timeout_us))
+
+
+/* 获取上一次睡眠的到期时刻 */
+static force_inline ktime_tick_t ktask_co_sleep_expiry_get(ktask_co_t *task)
+{
+    return ktimer_expiry_get(&task->sleep_timer);
+}
+
+
+/*********************************************************
+ *@简要：
+ ***初始化一组子操作，子操作的事件以task事件的优先级初始化
+ ***
+ ***将ktask_co_join_event返回的事件作为子操作完成时触发的事件，
+ ***例如kmsg_queue_pop的监听事件、ktimer的到期事件，或使用ktask_co_join_fork启动子协程。
+ ***子操作立即完成时，可使用kevent_post提交其事件
+ *
+ *@参数：
+ *[join]：子操作组
+ *[task]：等待子操作的父协程
+ *[entries]：可容纳nums个元素的数组
+ *[nums]：子操作的个数，不大于KTASK_CO_JOIN_NUMS_MAX
+ *[mode]：KTASK_CO_JOIN_ALL或KTASK_CO_JOIN_ANY
+ **********************************************************/
+void ktask_co_join_init(ktask_co_join_t *join, ktask_co_t *task,
+                        ktask_co_join_entry_t *entries, uint8_t nums, uint8_t mode);
+
+
+/* 获取序号对应的子操作完成事件 */
+static force_inline kevent_t *ktask_co_join_event(ktask_co_join_t *join, uint8_t idx)
+{
+    return &join->entries[idx].event;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***设置子操作的取消函数，KTASK_CO_JOIN_ANY模式下第一个子操作完成时，
+ ***将对其他未完成的子操作调用取消函数，例如kmsg_queue_push_wait_cancel、ktimer_stop
+ *
+ *@参数：
+ *[join]：子操作组
+ *[idx]：子操作序号
+ *[cancel]：取消函数
+ *[arg]：传递给取消函数的参数
+ **********************************************************/
+static force_inline void ktask_co_join_cancel_set(ktask_co_join_t *join, uint8_t idx,
+                                                  ktask_co_join_cancel_cb cancel, void *arg)
+{
+    join->entries[idx].cancel = cancel;
+    join->entries[idx].cancel_arg = arg;
+}
+
+
+/* 获取第一个完成的子操作序号，-1表示尚无子操作完成 */
+static force_inline int ktask_co_join_first(ktask_co_join_t *join)
+{
+    return join->first;
+}
+
+
+/* 判断序号对应的子操作是否已完成 */
+static force_inline bool ktask_co_join_is_done(ktask_co_join_t *join, uint8_t idx)
+{
+    return (join->done & BIT(idx)) != 0;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***判断子操作组是否完成，未完成时记录父协程正在等待，
+ ***完成时将触发父协程的事件
+ ***
+ ***此函数由ktask_co_bpd_join_wait使用，不应该被直接使用
+ *
+ *@返回值：
+ *[true]：子操作组已完成
+ *[false]：子操作组未完成
+ **********************************************************/
+bool ktask_co_join_wait(ktask_co_join_t *join);
+
+
+/* ktask_co_join_fork使用的取消函数，撤销对子协程结束的监听并以ktask_co_abort终止子协程；
+ * 只有处于睡眠或就绪状态的子协程会被终止。子协程的事件优先级低于父协程，
+ * 或任一方为KEVENT_PRIORITY_IMMED，或子协程正在等待其他队列（信号量、消息队列、
+ * 以ktask_co_event_inherit创建的事件等）时，子协程将继续运行至结束 */
+void ktask_co_join_task_cancel(kevent_t *ev, void *arg);
+
+
+/*********************************************************
+ *@简要：
+ ***启动一个子协程作为序号为idx的子操作，子协程结束时子操作完成
+ *
+ *@约定：
+ ***1、子协程拥有独立的ktask_co_t与异步栈，与父协程并发运行
+ ***2、子操作被取消时只终止处于睡眠或就绪状态的子协程，
+ ***   正在等待其他队列的子协程不会被终止，而是运行至结束，详见ktask_co_join_task_cancel
+ *
+ *@参数：
+ *[join]：子操作组
+ *[idx]：子操作序号
+ *[child]：子协程
+ *[child_func]：子协程的任务函数
+ *[...]：子协程任务函数的第3个及之后的参数
+ **********************************************************/
+#define ktask_co_join_fork(join, idx, child, child_func, ...)                           \
+    do {                                                                                \
+        ktask_co_join_cancel_set((join), (idx), ktask_co_join_task_cancel, (child));   \
+        ktask_co_end_wait((child), ktask_co_join_event((join), (idx)));                 \
+        task_start((child), child_func, ##__VA_ARGS__);                                 \
+    } while (0)
+
+
+/*********************************************************
+ *@简要：
+ ***等待子操作组完成，KTASK_CO_JOIN_ALL模式下等待所有子操作完成，
+ ***KTASK_CO_JOIN_ANY模式下等待任意一个子操作完成，
+ ***此时其他子操作已被取消，由ktask_co_join_first获取完成的子操作
+ *
+ *@约定：
+ ***不能使用空指针
+ *
+ *@参数：
+ *[bp_num]：用于恢复等待的，bpd断点号
+ *[join]：子操作组
+ **********************************************************/
+#define ktask_co_bpd_join_wait(bp_num, join)                                            \
+    do {                                                                                \
+        bpd_set(bp_num);                                                                \
+        bpd_restore_point(bp_num):;                                                     \
+        if (!ktask_co_join_wait(join)) {                                                \
+            return ;                                                                    \
+        }                                                                               \
+    } while (0)
+
+
 #endif /* __KTASK_CO_H__ */
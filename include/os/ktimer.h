@@ -80,4 +80,67 @@ static force_inline ktime_tick_t ktimer_expiry_get(ktimer_event_t *timer)
     return timer->expiry;
 }
 
+/***********************************
+ * 带超时的等待
+ ***********************************/
+
+/* 等待的结果 */
+enum
+{
+    /* 等待的条件已满足 */
+    KWAIT_OK = 0,
+
+    /* 等待超时 */
+    KWAIT_TIMEOUT = 1
+};
+
+/* 等待超时，嵌入在带超时的等待事件中 */
+typedef struct ktimeout_s {
+    /* 超时定时器 */
+    ktimer_event_t timer;
+
+    /* 等待者事件 */
+    kevent_t *waiter;
+
+    /* 等待者所在的等待队列 */
+    kevent_queue_t *wait_q;
+
+    /* 等待的结果，KWAIT_OK或KWAIT_TIMEOUT */
+    uint8_t status;
+} ktimeout_t;
+
+/*********************************************************
+ *@简要：
+ ***为已加入wait_q的等待者启动超时，到期时等待者将被移出wait_q，
+ ***并以KWAIT_TIMEOUT状态被触发
+ *
+ *@约定：
+ ***需要在将等待者加入wait_q的同一个irq_lock保护下调用
+ *
+ *@参数：
+ *[timeout]：等待超时
+ *[waiter]：等待者事件
+ *[wait_q]：等待者所在的等待队列
+ *[expiry]：到期时刻
+ **********************************************************/
+void ktimeout_start(ktimeout_t *timeout, kevent_t *waiter, kevent_queue_t *wait_q, ktime_tick_t expiry);
+
+/*********************************************************
+ *@简要：
+ ***等待的条件已满足，停止等待超时
+ *
+ *@约定：
+ ***需要在将等待者移出wait_q的同一个irq_lock保护下调用
+ *
+ *@参数：
+ *[timeout]：等待超时
+ **********************************************************/
+void ktimeout_stop(ktimeout_t *timeout);
+
+/* 获取等待的结果 */
+static force_inline uint8_t ktimeout_status_get(ktimeout_t *timeout)
+{
+    return timeout->status;
+}
+
 #endif /* __OS_TIMER_H__ */
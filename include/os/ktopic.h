@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2018-2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __OS_KTOPIC_H__
+#define __OS_KTOPIC_H__
+
+#include <os/kevent.h>
+#include <os/slab_mem.h>
+
+/* KTOPIC错误断言 */
+#ifndef KTOPIC_ASSERT
+#define KTOPIC_ASSERT(expr)
+#endif /* KTOPIC_ASSERT */
+
+/* 静态初始化时检查消息环深度，为0时编译失败 */
+#define KTOPIC_SUB_DEPTH_CHECK(depth)   \
+    ((depth) + 0 * sizeof(char[(depth) > 0 ? 1 : -1]))
+
+/* 发布/订阅主题，一条消息以引用计数的方式被所有订阅者共享，不做拷贝 */
+typedef struct ktopic_s {
+    /* 订阅者链表 */
+    slist_t subs;
+
+    /* 消息缓冲区所在的kslab分配器 */
+    kslab_mem_t *pool;
+} ktopic_t;
+
+/* 主题订阅者 */
+typedef struct ktopic_sub_s {
+    /* 订阅者链表节点 */
+    slist_node_t node;
+
+    /* 有新消息时触发的事件 */
+    kevent_t *listen_ev;
+
+    /* 待处理的消息环 */
+    void **slots;
+
+    /* 最多保留的消息条数，为1时仅保留最新消息，不能为0 */
+    uint8_t depth;
+
+    /* 最早的消息在消息环中的位置 */
+    uint8_t first;
+
+    /* 待处理的消息条数 */
+    uint8_t count;
+
+    uint8_t unused;
+
+    /* 因消息环已满而丢弃的消息条数 */
+    uint32_t dropped;
+} ktopic_sub_t;
+
+/* 消息头部，位于kslab内存块的起始处 */
+typedef struct ktopic_msg_hdr_s {
+    uint32_t ref;
+} ktopic_msg_hdr_t;
+
+/* 消息头部的大小，保证消息数据8字节对齐 */
+#define KTOPIC_MSG_HDR_SIZE         ALIGN8_UP(sizeof(ktopic_msg_hdr_t))
+
+/* 负载为payload_size的消息所需的kslab内存块大小 */
+#define KTOPIC_MSG_BLK_SIZE(payload_size)   (KTOPIC_MSG_HDR_SIZE + (payload_size))
+
+/* kslab内存块与消息数据的转换 */
+#define KTOPIC_MSG_OF_BLK(blk)      ((void *)((uint8_t *)(blk) + KTOPIC_MSG_HDR_SIZE))
+#define KTOPIC_BLK_OF_MSG(msg)      ((ktopic_msg_hdr_t *)((uint8_t *)(msg) - KTOPIC_MSG_HDR_SIZE))
+
+#define KTOPIC_STATIC_INIT(topic, pool) { SLIST_STATIC_INIT((topic).subs), (pool) }
+
+#define KTOPIC_SUB_STATIC_INIT(sub, slots, depth, listen_ev)    \
+{                                                               \
+    SLIST_NODE_STATIC_INIT((sub).node),                         \
+    (listen_ev), (slots), KTOPIC_SUB_DEPTH_CHECK(depth),        \
+    0, 0, 0, 0                                                  \
+}
+
+/************************************************************
+ *@简介：
+ ***使用static修饰定义一个订阅者及其消息环
+ *
+ *@参数：
+ *[_name]：订阅者的名字
+ *[depth]：最多保留的消息条数，为1时仅保留最新消息，不能为0
+ *[listen_ev]：有新消息时触发的事件
+ *************************************************************/
+#define KTOPIC_SUB_DEFINE_STATIC(_name, depth, listen_ev)                       \
+    static void *_name##_slots[(depth)];                                        \
+    static ktopic_sub_t _name = KTOPIC_SUB_STATIC_INIT(_name, _name##_slots,    \
+                                                       (depth), (listen_ev))
+
+/*********************************************
+ *@简要：初始化一个主题
+ *
+ *@参数：
+ *[topic] 主题
+ *[pool]  消息缓冲区所在的kslab分配器，内存块大小不小于KTOPIC_MSG_BLK_SIZE(消息大小)
+ *********************************************
+ */
+static inline void ktopic_init(ktopic_t *topic, kslab_mem_t *pool)
+{
+    slist_init(&topic->subs);
+    topic->pool = pool;
+}
+
+/*********************************************
+ *@简要：初始化一个订阅者
+ *
+ *@参数：
+ *[sub]       订阅者
+ *[slots]     消息环，可容纳depth个指针
+ *[depth]     最多保留的消息条数，为1时仅保留最新消息，不能为0
+ *[listen_ev] 有新消息时触发的事件
+ *********************************************
+ */
+static inline void ktopic_sub_init(ktopic_sub_t *sub, void **slots, uint8_t depth, kevent_t *listen_ev)
+{
+    KTOPIC_ASSERT(depth > 0);
+
+    slist_node_init(&sub->node);
+    sub->listen_ev = listen_ev;
+    sub->slots = slots;
+    sub->depth = depth;
+    sub->first = 0;
+    sub->count = 0;
+    sub->dropped = 0;
+}
+
+/*********************************************
+ *@简要：使用kslab内存块初始化一条消息，引用计数为1并由发布者持有
+ *
+ *@参数：
+ *[blk] 由主题的kslab分配器分配的内存块，例如kslab_mem_wait获得的内存块
+ *
+ *@返回：消息数据的地址
+ *********************************************
+ */
+static inline void *ktopic_msg_init(void *blk)
+{
+    ((ktopic_msg_hdr_t *)blk)->ref = 1;
+    return KTOPIC_MSG_OF_BLK(blk);
+}
+
+/*********************************************
+ *@简要：从主题的kslab分配器分配一条消息
+ *
+ *@返回：消息数据的地址，无可用内存时返回NULL
+ *********************************************
+ */
+static inline void *ktopic_msg_alloc(ktopic_t *topic)
+{
+    void *blk = kslab_mem_alloc(topic->pool);
+
+    return blk ? ktopic_msg_init(blk) : NULL;
+}
+
+/* 增加消息的引用 */
+void ktopic_msg_ref(void *msg);
+
+/* 释放消息的引用，最后一个引用被释放时消息将归还给kslab分配器 */
+void ktopic_msg_release(ktopic_t *topic, void *msg);
+
+/* 订阅主题，消息环深度为0的订阅者无法保存消息，不会被加入主题 */
+void ktopic_subscribe(ktopic_t *topic, ktopic_sub_t *sub);
+
+/* 取消订阅，并释放所有未处理的消息 */
+void ktopic_unsubscribe(ktopic_t *topic, ktopic_sub_t *sub);
+
+/*
+ * 发布消息，发布者持有的引用将被转交
+ * 每个订阅者获得消息的一个引用并触发其监听事件，订阅者消息环已满时丢弃最早的消息
+ * 监听事件在临界区之外提交，多个订阅者共用的监听事件每次发布只提交一次
+ */
+void ktopic_publish(ktopic_t *topic, void *msg);
+
+/*
+ * 取出订阅者最早的消息，调用者获得消息的引用，处理完成后需使用ktopic_msg_release释放
+ * 无消息时返回NULL
+ */
+void *ktopic_sub_take(ktopic_sub_t *sub);
+
+#endif /* __OS_KTOPIC_H__ */
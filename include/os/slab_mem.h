@@ -6,6 +6,7 @@
 #define __OS_SLAB_MEM_H__
 
 #include <os/kevent.h>
+#include <os/ktimer.h>
 #include <arch/irq.h>
 
 typedef struct kslab_mem_s {
@@ -13,9 +14,90 @@ typedef struct kslab_mem_s {
     lifo_t free_list;
 
     /* slab唤醒队列 */
-    fifo_t wait_q;
+    kevent_queue_t wait_q;
+
+    /* 从未被分配过的内存块，空闲链表为空时从此处按块顺序分配 */
+    uint8_t *unused_blk;
+
+    /* 内存块区域的结束地址 */
+    uint8_t *blk_end;
+
+    /* 每块的大小 */
+    uint32_t blk_size;
 } kslab_mem_t;
 
+/* kslab内存池描述符与内存块所在的段，内存块段不需要在启动时清零 */
+#ifndef KSLAB_DESC_SECTION
+#define KSLAB_DESC_SECTION      ".data.kslab_desc"
+#endif
+
+#ifndef KSLAB_POOL_SECTION
+#define KSLAB_POOL_SECTION      ".bss.kslab_pool"
+#endif
+
+/************************************************************
+ *@简介：
+ ***kslab分配器静态初始化，空闲块链表将在分配时延迟生成
+ *
+ *@用法：
+ ***kslab_mem_t slab = KSLAB_STATIC_INIT(slab, buff, blk_nums, blk_size);
+ *
+ *@参数：
+ *[slab]：slab变量名，非地址
+ *[buff]：内存块所在的buffer
+ *[blk_nums]：buffer的块数
+ *[blk_size]：每块的大小
+ *************************************************************/
+#define KSLAB_STATIC_INIT(slab, buff, blk_nums, blk_size)                       \
+{                                                                               \
+    LIFO_STATIC_INIT((slab).free_list),                                         \
+    KEVENT_QUEUE_STATIC_INIT((slab).wait_q),                                    \
+    (uint8_t *)(buff),                                                          \
+    (uint8_t *)(buff) + (blk_nums) * (blk_size),                                \
+    (blk_size)                                                                  \
+}
+
+/* kslab内存块类型，保证内存块可以容纳空闲链表节点，并满足type的对齐 */
+#define KSLAB_BLK_TYPE(type)    union { type blk; slist_node_t node; }
+
+/************************************************************
+ *@简介：
+ ***定义一个kslab分配器及其内存块，描述符与内存块放置于独立的链接段，
+ ***启动时无需执行任何初始化操作
+ *
+ *@参数：
+ *[_name]：kslab分配器的名字
+ *[type]：内存块的类型
+ *[count]：内存块的个数
+ *************************************************************/
+#define KSLAB_DEFINE(_name, type, count)                                        \
+    __section_zi(KSLAB_POOL_SECTION)                                            \
+    KSLAB_BLK_TYPE(type) _name##_slab_buf[(count)];                             \
+    __section(KSLAB_DESC_SECTION)                                               \
+    kslab_mem_t _name = KSLAB_STATIC_INIT(_name,                                \
+                                          _name##_slab_buf,                     \
+                                          (count),                              \
+                                          sizeof(_name##_slab_buf[0]))
+
+
+/************************************************************
+ *@简介：
+ ***使用static修饰定义一个kslab分配器及其内存块
+ *
+ *@参数：
+ *[_name]：kslab分配器的名字
+ *[type]：内存块的类型
+ *[count]：内存块的个数
+ *************************************************************/
+#define KSLAB_DEFINE_STATIC(_name, type, count)                                 \
+    __section_zi(KSLAB_POOL_SECTION)                                            \
+    static KSLAB_BLK_TYPE(type) _name##_slab_buf[(count)];                      \
+    __section(KSLAB_DESC_SECTION)                                               \
+    static kslab_mem_t _name = KSLAB_STATIC_INIT(_name,                         \
+                                                 _name##_slab_buf,              \
+                                                 (count),                       \
+                                                 sizeof(_name##_slab_buf[0]))
+
 /* slab事件 */
 typedef struct kslab_event_s {
     kevent_t event;
@@ -43,14 +125,31 @@ typedef struct kslab_event_s {
         (slab_event)->mem_blk = 0;                                  \
     } while (0)
 
+/* 带超时的slab事件 */
+typedef struct kslab_timed_event_s {
+    kslab_event_t slab_event;
+    ktimeout_t timeout;
+} kslab_timed_event_t;
+
+#define kslab_timed_event_init(timed_event, ecb, ctx, priority)     \
+    kslab_event_init(&(timed_event)->slab_event, (ecb), (ctx), (priority))
+
+#define kslab_timed_event_init_inherit(timed_event, parent)         \
+    kslab_event_init_inherit(&(timed_event)->slab_event, (parent))
+
+/* 获取等待的结果，KWAIT_OK或KWAIT_TIMEOUT */
+#define kslab_timed_event_status(timed_event)   ktimeout_status_get(&(timed_event)->timeout)
+
 /* kslab事件到节点的转换 */
 #define KSLAB_EVENT_EVENT(slab_event)   (&(slab_event)->event)
 #define KSLAB_EVENT_NODE(slab_event)    KEVENT_NODE(&(slab_event)->event)
 #define KSLAB_EVENT_OF_EVENT(event)    ((kslab_event_t*)(event))
 #define KSLAB_EVENT_OF_NODE(node)      KSLAB_EVENT_OF_EVENT(KEVENT_OF_NODE(node))
+#define KSLAB_TIMED_EVENT_OF_EVENT(event)   ((kslab_timed_event_t *)(event))
 
 /*********************************************
- *@简要：使用buffer初始化一个slab分配器
+ *@简要：使用buffer初始化一个slab分配器，
+ ***空闲块链表将在分配时延迟生成，因此初始化耗时与块数无关
  *
  *@参数：
  *[slab]	 slab
@@ -71,6 +170,44 @@ void kslab_mem_init(kslab_mem_t *slab, void *buff, uint32_t blk_nums, uint32_t b
  */
 #define kslab_mem_init_by_arr(slab, arr)    kslab_mem_init((slab), (arr), ARRAY_SIZE(arr), sizeof(*(arr)))
 
+/*********************************************
+ *@简要：判断slab分配器是否有可用的内存块，
+ ***需要在irq_lock保护下调用
+ *
+ *@参数：
+ *[slab] slab分配器
+ *********************************************
+ */
+static force_inline bool kslab_mem_has_free(kslab_mem_t *slab)
+{
+    return !lifo_is_empty(&slab->free_list) || slab->unused_blk < slab->blk_end;
+}
+
+/*********************************************
+ *@简要：从slab分配器中取出一个内存块，
+ ***优先使用空闲链表，否则从未分配过的区域中顺序取出，
+ ***需要在irq_lock保护下调用，并保证kslab_mem_has_free为真
+ *
+ *@参数：
+ *[slab] slab分配器
+ *
+ *@返回： 内存块
+ *********************************************
+ */
+static force_inline void *kslab_mem_blk_take(kslab_mem_t *slab)
+{
+    void *mem;
+
+    if (!lifo_is_empty(&slab->free_list)) {
+        return lifo_pop(&slab->free_list);
+    }
+
+    mem = slab->unused_blk;
+    slab->unused_blk += slab->blk_size;
+
+    return mem;
+}
+
 /*********************************************
  *@简要：slab分配器分配内存块
  *
@@ -85,8 +222,8 @@ static inline void *kslab_mem_alloc(kslab_mem_t *slab)
     int key = irq_lock();
     void *mem = 0;
 
-    if (!lifo_is_empty(&slab->free_list)) {
-        mem = lifo_pop(&slab->free_list);
+    if (kslab_mem_has_free(slab)) {
+        mem = kslab_mem_blk_take(slab);
     }
 
     irq_unlock(key);
@@ -136,4 +273,18 @@ static force_inline void kslab_mem_free_quiet(kslab_mem_t *slab, void *mem)
  */
 void kslab_mem_wait(kslab_mem_t *slab, kslab_event_t *slab_event);
 
+/*********************************************
+ *@简要：带超时地等待slab分配器内存块可用，
+ ***事件在获得内存块或者到达expiry时被触发，由kslab_timed_event_status区分两者，
+ ***超时时mem_blk为NULL
+ *
+ *@参数：
+ *[slab] slab分配器
+ *[timed_event] 带超时的slab事件
+ *[expiry] 到期时刻
+ *
+ *********************************************
+ */
+void kslab_mem_wait_timed(kslab_mem_t *slab, kslab_timed_event_t *timed_event, ktime_tick_t expiry);
+
 #endif /* __OS_SLAB_MEM_H__ */
@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __INCLUDE_PHEAP_H__
+#define __INCLUDE_PHEAP_H__
+
+#include <bases.h>
+
+/*********************************************************
+ *@类型说明：
+ *
+ *[pheap_node_t]：配对堆的节点
+ *[pheap_t]：配对堆
+ *
+ *@说明：
+ ***插入为O(1)，取出堆顶与删除任意节点为均摊O(log n)；
+ ***排序规则由调用者传入的before回调决定，同一个堆的所有操作需要使用相同的回调，
+ ***before认为相等的节点按插入的先后顺序取出
+ *********************************************************/
+typedef struct pheap_node_s {
+    /* 最左侧的子节点 */
+    struct pheap_node_s *child;
+
+    /* 右侧的兄弟节点 */
+    struct pheap_node_s *next;
+
+    /* 左侧的兄弟节点，最左侧的子节点指向父节点，堆顶为NULL，节点已删除时指向自身 */
+    struct pheap_node_s *prev;
+
+    /* 插入序号，用于保证相等节点的先进先出顺序 */
+    uint32_t seq;
+} pheap_node_t;
+
+typedef struct pheap_s {
+    /* 堆顶节点 */
+    pheap_node_t *root;
+
+    /* 下一个插入节点的序号 */
+    uint32_t seq;
+} pheap_t;
+
+/*********************************************************
+ *@简要：
+ ***配对堆的排序回调
+ *
+ *@返回值：
+ *[true]：a应该排在b之前
+ *[false]：a与b相等，或者b应该排在a之前
+ **********************************************************/
+typedef bool (*pheap_before_cb)(const pheap_node_t *a, const pheap_node_t *b);
+
+
+/************************************************************
+ *@简介：
+ ***配对堆结构体静态初始化
+ *
+ *@用法：
+ ***pheap_t heap = PHEAP_STATIC_INIT(heap);
+ *
+ *@参数：
+ *[heap]：配对堆变量名，非地址
+ *************************************************************/
+#define PHEAP_STATIC_INIT(heap) { NULL, 0 }
+
+
+/************************************************************
+ *@简介：
+ ***配对堆节点结构体静态初始化，初始化后的节点处于已删除状态
+ *
+ *@用法：
+ ***pheap_node_t node = PHEAP_NODE_STATIC_INIT(node);
+ *
+ *@参数：
+ *[node]：节点变量名，非地址
+ *************************************************************/
+#define PHEAP_NODE_STATIC_INIT(node) { NULL, NULL, &(node), 0 }
+
+
+/************************************************************
+ *@简介：
+ ***获取堆顶节点，堆为空时返回NULL
+ *
+ *@参数：
+ *[heap]：配对堆
+ *************************************************************/
+#define PHEAP_TOP(heap)     ((heap)->root)
+
+
+/*********************************************************
+ *@简要：
+ ***配对堆初始化
+ *
+ *@参数：
+ *[heap]：配对堆
+ **********************************************************/
+#define pheap_init(heap)            ((heap)->root = NULL, (heap)->seq = 0)
+
+
+/*********************************************************
+ *@简要：
+ ***配对堆节点初始化，初始化后的节点处于已删除状态
+ *
+ *@参数：
+ *[node]：节点
+ **********************************************************/
+#define pheap_node_init(node)       ((node)->child = (node)->next = NULL, (node)->prev = (node))
+
+
+/*********************************************************
+ *@简要：
+ ***判断配对堆是否为空
+ *
+ *@参数：
+ *[heap]：配对堆
+ **********************************************************/
+#define pheap_is_empty(heap)        ((heap)->root == NULL)
+
+
+/*********************************************************
+ *@简要：
+ ***判断节点是否处于已删除状态
+ *
+ *@参数：
+ *[node]：节点
+ *
+ *@返回值：
+ *[true]：节点已删除
+ *[false]：节点处于堆之中
+ **********************************************************/
+#define pheap_node_is_del(node)     ((node)->prev == (node))
+#define pheap_node_is_ref(node)     (!pheap_node_is_del(node))
+
+
+/*********************************************************
+ *@简要：
+ ***比较两个节点的先后，before相等时插入序号小的节点在前，
+ ***插入序号按回绕差值比较，同一个堆中的节点插入间隔不超过2^31次即可
+ **********************************************************/
+static force_inline bool pheap_node_before(const pheap_node_t *a, const pheap_node_t *b, pheap_before_cb before)
+{
+    if (before(a, b)) {
+        return true;
+    }
+
+    if (before(b, a)) {
+        return false;
+    }
+
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***合并两棵堆，排在后面的堆顶成为另一个堆顶的最左侧子节点
+ *
+ *@约定：
+ ***a与b均为堆顶，且不是空指针
+ *
+ *@返回：合并后的堆顶
+ **********************************************************/
+static force_inline pheap_node_t *pheap_meld(pheap_node_t *a, pheap_node_t *b, pheap_before_cb before)
+{
+    pheap_node_t *tmp;
+
+    if (pheap_node_before(b, a, before)) {
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将兄弟链表中的所有子堆两趟合并为一棵堆：
+ ***第一趟从左向右两两合并，第二趟从右向左依次合并
+ *
+ *@参数：
+ *[first]：最左侧的子堆，可以为NULL
+ *[before]：排序回调
+ *
+ *@返回：合并后的堆顶，first为NULL时返回NULL
+ **********************************************************/
+static inline pheap_node_t *pheap_merge_pairs(pheap_node_t *first, pheap_before_cb before)
+{
+    pheap_node_t *pairs = NULL;
+    pheap_node_t *root;
+    pheap_node_t *next;
+
+    if (first == NULL) {
+        return NULL;
+    }
+
+    /* 第一趟：两两合并，合并结果逆序链接在pairs之中 */
+    while (first) {
+        if (first->next == NULL) {
+            root = first;
+            first = NULL;
+        } else {
+            next = first->next->next;
+            root = pheap_meld(first, first->next, before);
+            first = next;
+        }
+
+        root->next = pairs;
+        pairs = root;
+    }
+
+    /* 第二趟：从右向左依次合并 */
+    root = pairs;
+    pairs = pairs->next;
+    while (pairs) {
+        next = pairs->next;
+        root = pheap_meld(root, pairs, before);
+        pairs = next;
+    }
+
+    root->next = NULL;
+    root->prev = NULL;
+
+    return root;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将节点插入配对堆，时间复杂度为O(1)
+ *
+ *@约定：
+ ***node为已删除的节点
+ *
+ *@参数：
+ *[heap]：配对堆
+ *[node]：被插入的节点
+ *[before]：排序回调
+ **********************************************************/
+static inline void pheap_push(pheap_t *heap, pheap_node_t *node, pheap_before_cb before)
+{
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    node->seq = heap->seq++;
+
+    if (heap->root) {
+        heap->root = pheap_meld(heap->root, node, before);
+        heap->root->prev = NULL;
+    } else {
+        heap->root = node;
+    }
+}
+
+
+/*********************************************************
+ *@简要：
+ ***取出堆顶节点，时间复杂度为均摊O(log n)
+ *
+ *@约定：
+ ***heap非空
+ *
+ *@参数：
+ *[heap]：配对堆
+ *[before]：排序回调
+ *
+ *@返回：被取出的节点
+ **********************************************************/
+static inline pheap_node_t *pheap_pop(pheap_t *heap, pheap_before_cb before)
+{
+    pheap_node_t *node = heap->root;
+
+    heap->root = pheap_merge_pairs(node->child, before);
+    pheap_node_init(node);
+
+    return node;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***从配对堆中删除节点，时间复杂度为均摊O(log n)
+ *
+ *@约定：
+ ***node已删除或处于heap之中，不能处于其他堆之中
+ *
+ *@参数：
+ *[heap]：配对堆
+ *[node]：被删除的节点
+ *[before]：排序回调
+ *
+ *@返回值：
+ *[true]：成功从堆中删除这个节点
+ *[false]：这个节点已被删除
+ **********************************************************/
+static inline bool pheap_del_node(pheap_t *heap, pheap_node_t *node, pheap_before_cb before)
+{
+    pheap_node_t *sub;
+
+    if (pheap_node_is_del(node)) {
+        return false;
+    }
+
+    if (node == heap->root) {
+        pheap_pop(heap, before);
+        return true;
+    }
+
+    /* 从兄弟链表中摘除节点 */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+
+    /* 将节点的子堆合并回堆中 */
+    sub = pheap_merge_pairs(node->child, before);
+    if (sub) {
+        heap->root = pheap_meld(heap->root, sub, before);
+        heap->root->prev = NULL;
+        heap->root->next = NULL;
+    }
+
+    pheap_node_init(node);
+    return true;
+}
+
+
+/*********************************************************
+ *@简要：
+ ***将堆中的所有节点合并至接收堆，合并完成后，原堆变成空；
+ ***接收堆为空时保持原堆中相等节点的顺序
+ *
+ *@参数：
+ *[heap]：被转移的堆
+ *[recv_heap]：接收节点的堆
+ *[before]：排序回调
+ **********************************************************/
+static inline void pheap_nodes_transfer_to(pheap_t *heap, pheap_t *recv_heap, pheap_before_cb before)
+{
+    if (heap->root == NULL) {
+        return;
+    }
+
+    if (recv_heap->root) {
+        recv_heap->root = pheap_meld(recv_heap->root, heap->root, before);
+        recv_heap->root->prev = NULL;
+        recv_heap->root->next = NULL;
+    } else {
+        recv_heap->root = heap->root;
+        recv_heap->seq = heap->seq;
+    }
+
+    heap->root = NULL;
+}
+
+#endif /* __INCLUDE_PHEAP_H__ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <os/irq_profile.h>
+#include <arch/irq.h>
+#include <string.h>
+
+#if IRQ_LOCK_PROFILE
+/* 正在进行的临界区 */
+typedef struct irq_lock_current_s {
+    /* irq_lock的嵌套层数 */
+    uint32_t depth;
+
+    /* 最外层临界区的开始周期数与调用位置 */
+    uint32_t start;
+    const char *file;
+    uint32_t line;
+} irq_lock_current_t;
+
+static irq_lock_current_t irq_lock_current;
+
+static irq_lock_profile_t irq_lock_profile;
+
+/* 以调用位置记录临界区的时长，保持从大到小排列，需要在中断关闭时调用 */
+static void irq_lock_section_record(const char *file, uint32_t line, uint32_t cycles)
+{
+    irq_lock_section_t *sections = irq_lock_profile.sections;
+    uint32_t i;
+
+    /* 内联函数中的__FILE__在不同的编译单元中不是同一个字符串，因此比较内容 */
+    for (i = 0; i < irq_lock_profile.nums; i++) {
+        if (sections[i].line == line && strcmp(sections[i].file, file) == 0) {
+            break;
+        }
+    }
+
+    if (i < irq_lock_profile.nums) {
+        /* 该位置已有更长的记录 */
+        if (cycles <= sections[i].cycles) {
+            return;
+        }
+    } else if (irq_lock_profile.nums < IRQ_LOCK_PROFILE_NUMS) {
+        /* 使用一个空闲的记录 */
+        irq_lock_profile.nums++;
+    } else {
+        /* 替换最短的记录 */
+        i = IRQ_LOCK_PROFILE_NUMS - 1;
+        if (cycles <= sections[i].cycles) {
+            return;
+        }
+    }
+
+    /* 从位置i向前移动到有序的位置 */
+    while (i > 0 && sections[i - 1].cycles < cycles) {
+        sections[i] = sections[i - 1];
+        i--;
+    }
+
+    sections[i].file = file;
+    sections[i].line = line;
+    sections[i].cycles = cycles;
+}
+
+int irq_lock_profile_enter(int key, const char *file, uint32_t line)
+{
+    if (irq_lock_current.depth++ == 0) {
+        irq_lock_current.file = file;
+        irq_lock_current.line = line;
+        irq_lock_current.start = irq_lock_profile_cycles_get();
+    }
+
+    return key;
+}
+
+int irq_lock_profile_exit(int key)
+{
+    uint32_t end = irq_lock_profile_cycles_get();
+
+    /* 临界区已由irq_lock_profile_handoff结束 */
+    if (irq_lock_current.depth == 0) {
+        return key;
+    }
+
+    if (--irq_lock_current.depth == 0) {
+        irq_lock_profile.count++;
+        irq_lock_section_record(irq_lock_current.file,
+                                irq_lock_current.line,
+                                end - irq_lock_current.start);
+    }
+
+    return key;
+}
+#endif /* IRQ_LOCK_PROFILE */
+
+void irq_lock_profile_get(irq_lock_profile_t *profile)
+{
+#if IRQ_LOCK_PROFILE
+    int key;
+
+    /* 不使用irq_lock，避免读取结果的临界区被记录 */
+    key = arch_irq_lock();
+    *profile = irq_lock_profile;
+    arch_irq_unlock(key);
+#else
+    memset(profile, 0, sizeof(*profile));
+#endif /* IRQ_LOCK_PROFILE */
+}
+
+void irq_lock_profile_reset(void)
+{
+#if IRQ_LOCK_PROFILE
+    int key;
+
+    key = arch_irq_lock();
+    irq_lock_profile.count = 0;
+    irq_lock_profile.nums = 0;
+    arch_irq_unlock(key);
+#endif /* IRQ_LOCK_PROFILE */
+}
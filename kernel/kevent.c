@@ -6,22 +6,36 @@
 #include <arch/irq.h>
 
 typedef struct kevent_scheduler_s {
-    fifo_t ready_groups[KEVENT_PRIORITY_GROUP_COUNT];
+    kevent_queue_t ready_groups[KEVENT_PRIORITY_GROUP_COUNT];
 
     uint8_t ready_map;
 
     uint8_t schedule_pending;
 
     int16_t scheduling_priority;
+
+#if KEVENT_STACK_MONITOR
+    /* 当前调度的嵌套层数 */
+    uint8_t nesting;
+
+    kevent_stack_info_t stack_info[KEVENT_PRIORITY_GROUP_COUNT];
+#endif /* KEVENT_STACK_MONITOR */
 } kevent_scheduler_t;
 
 
+/* 由PendSV调度的事件组就绪图，不包含由中断调度的事件组 */
+#if KEVENT_IRQ_GROUP_NUMS
+#define SCHEDULER_SOFT_READY_MAP(ready_map) ((ready_map) & (BIT(KEVENT_IRQ_GROUP_FIRST) - 1))
+#else
+#define SCHEDULER_SOFT_READY_MAP(ready_map) (ready_map)
+#endif /* KEVENT_IRQ_GROUP_NUMS */
+
 static kevent_scheduler_t scheduler = {
     {
-        FIFO_STATIC_INIT(scheduler.ready_groups[0]),
-        FIFO_STATIC_INIT(scheduler.ready_groups[1]),
-        FIFO_STATIC_INIT(scheduler.ready_groups[2]),
-        FIFO_STATIC_INIT(scheduler.ready_groups[3])
+        KEVENT_QUEUE_STATIC_INIT(scheduler.ready_groups[0]),
+        KEVENT_QUEUE_STATIC_INIT(scheduler.ready_groups[1]),
+        KEVENT_QUEUE_STATIC_INIT(scheduler.ready_groups[2]),
+        KEVENT_QUEUE_STATIC_INIT(scheduler.ready_groups[3])
     },
     0,
     0,
@@ -29,26 +43,31 @@ static kevent_scheduler_t scheduler = {
 };
 
 
-void kevent_fifo_priority_push(fifo_t *epfifo, kevent_t *event)
+void kevent_fifo_priority_push(kevent_queue_t *epfifo, kevent_t *event)
 {
-    kevent_t *insert_pos = KEVENT_OF_NODE(FIFO_TAIL(epfifo));
-    slist_node_t *prev_node, *node;
+#if KEVENT_NODE_PHEAP
+    /* 堆按优先级排序，相同优先级按先进先出排序 */
+    kevent_queue_push(epfifo, KEVENT_NODE(event));
+#else
+    kevent_t *insert_pos = KEVENT_OF_NODE(KEVENT_QUEUE_TAIL(epfifo));
+    kevent_node_t *prev_node, *node;
 
     /* 如果队列空或者当前事件优先级低于队尾优先级，则将事件插入到尾部 */
-    if (fifo_is_empty(epfifo) || 
+    if (kevent_queue_is_empty(epfifo) || 
         KEVENT_PRIORITY(event) <= KEVENT_PRIORITY(insert_pos)) {
-        fifo_push(epfifo, KEVENT_NODE(event));
+        kevent_queue_push(epfifo, KEVENT_NODE(event));
     } else {
         /* 从头按优先级查找插入的位置 */
-        slist_foreach_record_prev(FIFO_LIST(epfifo), node, prev_node) {
+        kevent_queue_foreach_record_prev(epfifo, node, prev_node) {
             insert_pos = container_of(node, kevent_t, node);
 
             if (KEVENT_PRIORITY(event) > KEVENT_PRIORITY(insert_pos)) {
-                fifo_node_insert_next(epfifo, prev_node, KEVENT_NODE(event));
+                kevent_queue_insert_next(epfifo, prev_node, KEVENT_NODE(event));
                 break;
             }
         }
     }
+#endif /* KEVENT_NODE_PHEAP */
 }
 
 
@@ -66,7 +85,7 @@ void kevent_post(kevent_t *e)
     key = irq_lock();
 
     /* 事件节点必须处于空闲状态 */
-    if (slist_node_is_del(KEVENT_NODE(e))) {
+    if (kevent_node_is_del(KEVENT_NODE(e))) {
         priority = e->priority;
         ready_group = priority >> KEVENT_READY_GROUP_PRIORITY_SHIFT;
 
@@ -76,9 +95,12 @@ void kevent_post(kevent_t *e)
         e->is_ready = 1;
         scheduler.ready_map |= (1 << ready_group);
 
-        /* 若提交的事件大于正在调度事件的优先级，则挂起抢占 */
-        if (priority > scheduler.scheduling_priority &&
-            !scheduler.schedule_pending) {
+        if (ready_group >= KEVENT_IRQ_GROUP_FIRST) {
+            /* 由中断调度的事件组直接挂起其中断，由NVIC完成抢占 */
+            arch_irq_set_pending(KEVENT_IRQ_GROUP_IRQN(ready_group));
+        } else if (priority > scheduler.scheduling_priority &&
+                   !scheduler.schedule_pending) {
+            /* 若提交的事件大于正在调度事件的优先级，则挂起抢占 */
             scheduler.schedule_pending = 1;
             arch_irq_schedule_pending();
         }
@@ -91,7 +113,7 @@ void kevent_post(kevent_t *e)
 void kevent_cancel(kevent_t *e)
 {
     uint8_t ready_group;
-    fifo_t *ready_q;
+    kevent_queue_t *ready_q;
     int key;
 
     key = irq_lock();
@@ -99,11 +121,11 @@ void kevent_cancel(kevent_t *e)
     ready_group = e->priority >> KEVENT_READY_GROUP_PRIORITY_SHIFT;
     ready_q = &scheduler.ready_groups[ready_group];
 
-    /* 节点非空闲状态则从事件组中删除 */
-    if (!slist_node_is_del(KEVENT_NODE(e))
-        && fifo_del_node(ready_q, KEVENT_NODE(e))) {
+    /* 事件就绪时才处于事件组中，未就绪的事件可能处于其他等待队列之中 */
+    if (kevent_is_ready(e)
+        && kevent_queue_del_node(ready_q, KEVENT_NODE(e))) {
         /* 若事件组为空，则更新就绪图 */
-        if (fifo_is_empty(ready_q)) {
+        if (kevent_queue_is_empty(ready_q)) {
             scheduler.ready_map &= ~(1 << ready_group);
         }
 
@@ -113,6 +135,34 @@ void kevent_cancel(kevent_t *e)
     irq_unlock(key);
 }
 
+/* 记录事件组的调度嵌套层数与栈指针，需要在irq_lock保护下调用 */
+static force_inline void scheduler_stack_track(uint8_t ready_group)
+{
+#if KEVENT_STACK_MONITOR
+    kevent_stack_info_t *info = &scheduler.stack_info[ready_group];
+    uintptr_t sp = arch_stack_pointer_get();
+
+    if (scheduler.nesting > info->depth_peak) {
+        info->depth_peak = scheduler.nesting;
+    }
+
+    if (info->sp_min == 0 || sp < info->sp_min) {
+        info->sp_min = sp;
+    }
+#else
+    (void)ready_group;
+#endif /* KEVENT_STACK_MONITOR */
+}
+
+/* 调度嵌套层数的进入与退出，需要在irq_lock保护下调用 */
+#if KEVENT_STACK_MONITOR
+#define scheduler_nesting_enter()   (scheduler.nesting++)
+#define scheduler_nesting_exit()    (scheduler.nesting--)
+#else
+#define scheduler_nesting_enter()   ((void)0)
+#define scheduler_nesting_exit()    ((void)0)
+#endif /* KEVENT_STACK_MONITOR */
+
 static force_inline uint8_t scheduler_highest_ready_group_get(uint8_t ready_map)
 {
     static const uint8_t priority_ready_bitmap[] = {
@@ -124,32 +174,33 @@ static force_inline uint8_t scheduler_highest_ready_group_get(uint8_t ready_map)
     return priority_ready_bitmap[ready_map];
 }
 
-void kevent_schedule(void)
+/* 调度比当前正在调度的优先级更高的事件，需要在irq_lock保护下调用，返回时仍处于irq_lock保护之下 */
+static force_inline void scheduler_run(int key)
 {
     kevent_t *e;
-    fifo_t *ready_q;
+    kevent_queue_t *ready_q;
     uint8_t ready_group;
     int32_t old_scheduling_priority;
     uint8_t priority;
-    int key;
 
-    key = irq_lock();
     /* 保存前一次正在调度的优先级，以便后续恢复 */
     old_scheduling_priority = scheduler.scheduling_priority;
 
     /* 清除调度挂起标识 */
     scheduler.schedule_pending = 0;
 
+    scheduler_nesting_enter();
+
     while (1) {
         /* 获取当前最高优先级的事件组 */
-        ready_group = scheduler_highest_ready_group_get(scheduler.ready_map);
+        ready_group = scheduler_highest_ready_group_get(SCHEDULER_SOFT_READY_MAP(scheduler.ready_map));
         if (ready_group >= KEVENT_PRIORITY_GROUP_COUNT) {
             break;
         }
 
         /* 获取最高优先级的事件 */
         ready_q = &scheduler.ready_groups[ready_group];
-        e = KEVENT_OF_NODE(FIFO_TOP(ready_q));
+        e = KEVENT_OF_NODE(KEVENT_QUEUE_TOP(ready_q));
         priority = e->priority;
 
         /* 只调度比当前优先级更高的事件 */
@@ -158,9 +209,9 @@ void kevent_schedule(void)
         }
 
         /* 取出这个事件以执行调度 */
-        fifo_pop(ready_q);
+        kevent_queue_pop(ready_q);
         /* 若事件为空，则清除该组就绪map */
-        if (fifo_is_empty(ready_q)) {
+        if (kevent_queue_is_empty(ready_q)) {
             scheduler.ready_map &= ~(1UL << ready_group);
         }
 
@@ -168,16 +219,108 @@ void kevent_schedule(void)
         /* 设置正在调度的优先级 */
         scheduler.scheduling_priority = priority;
 
+        scheduler_stack_track(ready_group);
+
         /* 打开中断并调度这个事件 */
         irq_unlock(key);
         e->callback(e->cb_data, e);
         key = irq_lock();
     }
 
+    scheduler_nesting_exit();
+
     /* 恢复前一次调度优先级 */
     scheduler.scheduling_priority = old_scheduling_priority;
+}
+
+void kevent_schedule(void)
+{
+    int key;
+
+    key = irq_lock();
+    scheduler_run(key);
+    irq_unlock(key);
+}
+
+bool kevent_preempt_check(void)
+{
+    uint8_t ready_group;
+    kevent_t *e;
+    bool res = false;
+    int key;
+
+    key = irq_lock();
+
+    ready_group = scheduler_highest_ready_group_get(SCHEDULER_SOFT_READY_MAP(scheduler.ready_map));
+    if (ready_group < KEVENT_PRIORITY_GROUP_COUNT) {
+        e = KEVENT_OF_NODE(KEVENT_QUEUE_TOP(&scheduler.ready_groups[ready_group]));
+        res = e->priority > scheduler.scheduling_priority;
+    }
 
+    /* 无需抢占时清除调度挂起标识，此后提交的事件将重新挂起抢占 */
+    if (!res) {
+        scheduler.schedule_pending = 0;
+    }
+
+    irq_unlock(key);
+    return res;
+}
+
+void kevent_preempt_schedule(void)
+{
+    /* 返回时保持中断关闭，由抢占程序在恢复被抢占的上下文之后再打开中断 */
+    scheduler_run(irq_lock());
+
+    /* 中断由抢占程序打开，在此结束临界区的计时 */
+    irq_lock_profile_handoff();
+}
+
+void kevent_irq_group_schedule(uint8_t ready_group)
+{
+    kevent_queue_t *ready_q = &scheduler.ready_groups[ready_group];
+    kevent_t *e;
+    int key;
+
+    /* 组内的事件依次执行，scheduling_priority只记录PendSV的调度状态，
+     * 因此回调中提交的低优先级事件仍会正确的挂起PendSV
+     */
+    key = irq_lock();
+
+    scheduler_nesting_enter();
+
+    while (!kevent_queue_is_empty(ready_q)) {
+        e = KEVENT_OF_NODE(kevent_queue_pop(ready_q));
+        if (kevent_queue_is_empty(ready_q)) {
+            scheduler.ready_map &= ~(1UL << ready_group);
+        }
+
+        e->is_ready = 0;
+
+        scheduler_stack_track(ready_group);
+
+        irq_unlock(key);
+        e->callback(e->cb_data, e);
+        key = irq_lock();
+    }
+
+    scheduler_nesting_exit();
+
+    irq_unlock(key);
+}
+
+void kevent_stack_info_get(uint8_t ready_group, kevent_stack_info_t *info)
+{
+#if KEVENT_STACK_MONITOR
+    int key;
+
+    key = irq_lock();
+    *info = scheduler.stack_info[ready_group];
     irq_unlock(key);
+#else
+    (void)ready_group;
+    info->sp_min = 0;
+    info->depth_peak = 0;
+#endif /* KEVENT_STACK_MONITOR */
 }
 
 bool kevent_scheduler_busy(void)
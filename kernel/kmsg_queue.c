@@ -4,23 +4,153 @@
 
 #include <os/kernel.h>
 
+/* 撤销多路等待在所有消息队列上的代理事件，需要在irq_lock保护下调用 */
+static void kmsg_select_unregister(kmsg_select_t *select)
+{
+    kmsg_select_entry_t *entry;
+    uint8_t i;
+
+    for (i = 0; i < select->nums; i++) {
+        entry = &select->entries[i];
+        if (!kevent_node_is_del(KEVENT_NODE(&entry->proxy))) {
+            kevent_queue_del_node(&entry->kmsg_q->wait_q, KEVENT_NODE(&entry->proxy));
+        }
+    }
+}
+
+/* 多路等待的代理事件被唤醒，需要在irq_lock保护下调用 */
+static void kmsg_select_wakeup(kevent_t *proxy)
+{
+    kmsg_select_entry_t *entry = container_of(proxy, kmsg_select_entry_t, proxy);
+    kmsg_select_t *select = entry->select;
+
+    select->ready = entry - select->entries;
+    kmsg_select_unregister(select);
+
+    kevent_post(select->listen_ev);
+}
+
+/* 将消息加入队列，并唤醒监听事件，需要在irq_lock保护下调用 */
+static void kmsg_queue_enqueue(kmsg_queue_t *kmsg_q, slist_node_t *msg)
+{
+    kevent_t *listen_ev;
+
+    fifo_push(&kmsg_q->msg_q, msg);
+    kmsg_q->count++;
+
+    /* 每条消息唤醒优先级最高的监听事件，或者唤醒所有的监听事件 */
+    while (!kevent_queue_is_empty(&kmsg_q->wait_q)) {
+        listen_ev = KEVENT_OF_NODE(kevent_queue_pop(&kmsg_q->wait_q));
+        if (listen_ev->flags & KEVENT_FLAG_TIMED) {
+            ktimeout_stop(&KMSG_TIMED_EVENT_OF_EVENT(listen_ev)->timeout);
+        }
+
+        if (listen_ev->flags & KEVENT_FLAG_SELECT) {
+            kmsg_select_wakeup(listen_ev);
+        } else {
+            kevent_post(listen_ev);
+        }
+
+        if (!(kmsg_q->flags & KMSG_QUEUE_FLAG_WAKE_ALL)) {
+            break;
+        }
+    }
+}
+
+/* 按优先级添加监听事件，需要在irq_lock保护下调用 */
+static force_inline void kmsg_queue_listen(kmsg_queue_t *kmsg_q, kevent_t *listen_ev)
+{
+    if (listen_ev && !kevent_is_ref(listen_ev)) {
+        kevent_fifo_priority_push(&kmsg_q->wait_q, listen_ev);
+    }
+}
+
+/* 队列空间被释放，按优先级将等待中的生产者消息加入队列，需要在irq_lock保护下调用 */
+static void kmsg_queue_space_release(kmsg_queue_t *kmsg_q)
+{
+    kmsg_push_event_t *push_ev;
+
+    while (!kevent_queue_is_empty(&kmsg_q->push_wait_q) &&
+           kmsg_q->count < kmsg_q->capacity) {
+        push_ev = KMSG_PUSH_EVENT_OF_NODE(kevent_queue_pop(&kmsg_q->push_wait_q));
+
+        kmsg_queue_enqueue(kmsg_q, push_ev->msg);
+        kevent_post(&push_ev->event);
+    }
+}
+
+/* 队列是否已满 */
+static force_inline bool kmsg_queue_is_full(kmsg_queue_t *kmsg_q)
+{
+    return kmsg_q->capacity && kmsg_q->count >= kmsg_q->capacity;
+}
+
 void kmsg_queue_push(kmsg_queue_t *kmsg_q, slist_node_t *msg)
 {
     int key;
-    kevent_t *listen_ev;
 
     key = irq_lock();
 
     if (slist_node_is_del(msg)) {
-        fifo_push(&kmsg_q->msg_q, msg);
+        kmsg_queue_enqueue(kmsg_q, msg);
+    }
 
-        if (!lifo_is_empty(&kmsg_q->wait_q)) {
-            listen_ev = KEVENT_OF_NODE(lifo_pop(&kmsg_q->wait_q));
-            kevent_post(listen_ev);
+    irq_unlock(key);
+}
+
+bool kmsg_queue_try_push(kmsg_queue_t *kmsg_q, slist_node_t *msg)
+{
+    int key;
+    bool res = false;
+
+    key = irq_lock();
+
+    if (slist_node_is_del(msg) && !kmsg_queue_is_full(kmsg_q)) {
+        kmsg_queue_enqueue(kmsg_q, msg);
+        res = true;
+    }
+
+    irq_unlock(key);
+    return res;
+}
+
+int kmsg_queue_push_wait(kmsg_queue_t *kmsg_q, slist_node_t *msg, kmsg_push_event_t *push_ev)
+{
+    int key;
+    int res = KMSG_PUSH_LINKED;
+
+    key = irq_lock();
+
+    if (slist_node_is_del(msg)) {
+        res = KMSG_PUSH_WAIT;
+        if (!kmsg_queue_is_full(kmsg_q)) {
+            kmsg_queue_enqueue(kmsg_q, msg);
+            res = KMSG_PUSH_OK;
+        } else if (!kevent_is_ref(&push_ev->event)) {
+            /* 队列已满，按优先级等待队列空间 */
+            push_ev->msg = msg;
+            kevent_fifo_priority_push(&kmsg_q->push_wait_q, KMSG_PUSH_EVENT_EVENT(push_ev));
         }
     }
 
     irq_unlock(key);
+    return res;
+}
+
+bool kmsg_queue_push_wait_cancel(kmsg_queue_t *kmsg_q, kmsg_push_event_t *push_ev)
+{
+    int key;
+    bool res = false;
+
+    key = irq_lock();
+
+    if (!kevent_node_is_del(KEVENT_NODE(&push_ev->event)) &&
+        !kevent_is_ready(&push_ev->event)) {
+        res = kevent_queue_del_node(&kmsg_q->push_wait_q, KEVENT_NODE(&push_ev->event));
+    }
+
+    irq_unlock(key);
+    return res;
 }
 
 slist_node_t *kmsg_queue_pop(kmsg_queue_t *kmsg_q, kevent_t *listen_ev)
@@ -32,13 +162,151 @@ slist_node_t *kmsg_queue_pop(kmsg_queue_t *kmsg_q, kevent_t *listen_ev)
 
     if (fifo_is_empty(&kmsg_q->msg_q)) {
         node = NULL;
-        if (listen_ev && !kevent_is_ref(listen_ev)) {
-            lifo_push(&kmsg_q->wait_q, KEVENT_NODE(listen_ev));
-        }
+        kmsg_queue_listen(kmsg_q, listen_ev);
     } else {
         node = fifo_pop(&kmsg_q->msg_q);
+        kmsg_q->count--;
+        kmsg_queue_space_release(kmsg_q);
     }
 
     irq_unlock(key);
     return node;
 }
+
+slist_node_t *kmsg_queue_pop_timed(kmsg_queue_t *kmsg_q, kmsg_timed_event_t *listen_ev, ktime_tick_t expiry)
+{
+    int key;
+    slist_node_t *node = NULL;
+
+    key = irq_lock();
+
+    if (!fifo_is_empty(&kmsg_q->msg_q)) {
+        node = fifo_pop(&kmsg_q->msg_q);
+        kmsg_q->count--;
+        kmsg_queue_space_release(kmsg_q);
+        listen_ev->timeout.status = KWAIT_OK;
+    } else if (!kevent_is_ref(&listen_ev->event)) {
+        /* 加入等待队列与启动超时在同一个临界区中完成 */
+        kevent_fifo_priority_push(&kmsg_q->wait_q, &listen_ev->event);
+        ktimeout_start(&listen_ev->timeout, &listen_ev->event, &kmsg_q->wait_q, expiry);
+    }
+
+    irq_unlock(key);
+    return node;
+}
+
+bool kmsg_queue_pop_all(kmsg_queue_t *kmsg_q, fifo_t *out, kevent_t *listen_ev)
+{
+    int key;
+    bool res;
+
+    key = irq_lock();
+
+    res = !fifo_is_empty(&kmsg_q->msg_q);
+    if (res) {
+        fifo_nodes_transfer_to(&kmsg_q->msg_q, out);
+        kmsg_q->count = 0;
+        kmsg_queue_space_release(kmsg_q);
+    } else {
+        kmsg_queue_listen(kmsg_q, listen_ev);
+    }
+
+    irq_unlock(key);
+    return res;
+}
+
+uint32_t kmsg_queue_pop_n(kmsg_queue_t *kmsg_q, fifo_t *out, uint32_t max_nums, kevent_t *listen_ev)
+{
+    int key;
+    uint32_t nums = 0;
+    slist_node_t *first, *last;
+
+    key = irq_lock();
+
+    if (fifo_is_empty(&kmsg_q->msg_q)) {
+        kmsg_queue_listen(kmsg_q, listen_ev);
+    } else if (max_nums) {
+        /* 查找第max_nums个消息，并将其之前的消息整段转移至out */
+        first = FIFO_TOP(&kmsg_q->msg_q);
+        last = first;
+        nums = 1;
+        while (nums < max_nums && last != FIFO_TAIL(&kmsg_q->msg_q)) {
+            last = SLIST_NODE_NEXT(last);
+            nums++;
+        }
+
+        if (last == FIFO_TAIL(&kmsg_q->msg_q)) {
+            fifo_nodes_transfer_to(&kmsg_q->msg_q, out);
+        } else {
+            SLIST_NODE_NEXT(SLIST_HEAD(FIFO_LIST(&kmsg_q->msg_q))) = SLIST_NODE_NEXT(last);
+
+            SLIST_NODE_NEXT(last) = SLIST_HEAD(FIFO_LIST(out));
+            SLIST_NODE_NEXT(FIFO_TAIL(out)) = first;
+            FIFO_TAIL(out) = last;
+        }
+
+        kmsg_q->count -= nums;
+        kmsg_queue_space_release(kmsg_q);
+    }
+
+    irq_unlock(key);
+    return nums;
+}
+
+void kmsg_select_init(kmsg_select_t *select, kmsg_select_entry_t *entries,
+                      kmsg_queue_t *const *kmsg_qs, uint8_t nums, kevent_t *listen_ev)
+{
+    uint8_t i;
+
+    select->listen_ev = listen_ev;
+    select->entries = entries;
+    select->nums = nums;
+    select->ready = -1;
+
+    for (i = 0; i < nums; i++) {
+        /* 代理事件以监听事件的优先级在消息队列上排队 */
+        kevent_init(&entries[i].proxy, (kevent_cb)0, select, KEVENT_PRIORITY(listen_ev));
+        entries[i].proxy.flags = KEVENT_FLAG_SELECT;
+        entries[i].kmsg_q = kmsg_qs[i];
+        entries[i].select = select;
+    }
+}
+
+int kmsg_select(kmsg_select_t *select)
+{
+    kmsg_select_entry_t *entry;
+    uint8_t i;
+    int key;
+
+    key = irq_lock();
+
+    /* 撤销上一次未完成的监听 */
+    kmsg_select_unregister(select);
+    select->ready = -1;
+
+    for (i = 0; i < select->nums; i++) {
+        if (!fifo_is_empty(&select->entries[i].kmsg_q->msg_q)) {
+            select->ready = i;
+            irq_unlock(key);
+            return i;
+        }
+    }
+
+    /* 所有队列为空，在所有队列上设置监听 */
+    for (i = 0; i < select->nums; i++) {
+        entry = &select->entries[i];
+        kevent_fifo_priority_push(&entry->kmsg_q->wait_q, &entry->proxy);
+    }
+
+    irq_unlock(key);
+    return -1;
+}
+
+void kmsg_select_cancel(kmsg_select_t *select)
+{
+    int key = irq_lock();
+
+    kmsg_select_unregister(select);
+
+    irq_unlock(key);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <os/kmutex.h>
+#include <arch/irq.h>
+
+/* 修改持有者事件的优先级，需要在irq_lock保护下调用
+ * 就绪的事件按新的优先级重新排队；处于其他等待队列之中的事件保持原优先级，
+ * 原地修改会破坏该队列的优先级顺序或堆的性质，而该队列无法由事件得知 */
+static void kmutex_event_priority_set(kevent_t *ev, uint8_t priority)
+{
+    if (KEVENT_PRIORITY(ev) == priority) {
+        return;
+    }
+
+    if (kevent_is_ready(ev)) {
+        kevent_cancel(ev);
+        KEVENT_PRIORITY(ev) = priority;
+        kevent_post(ev);
+    } else if (kevent_node_is_del(KEVENT_NODE(ev))) {
+        KEVENT_PRIORITY(ev) = priority;
+    }
+}
+
+/* 按等待事件的最高优先级更新持有者的优先级，
+ * 在等待队列的操作之后以单独的临界区调用，以当前的持有者与等待队列重新计算 */
+static void kmutex_inherit_update(kmutex_t *mutex)
+{
+    uint8_t priority;
+    uint8_t wait_priority;
+    int key;
+
+    if (!(mutex->flags & KMUTEX_FLAG_INHERIT)) {
+        return;
+    }
+
+    key = irq_lock();
+
+    /* 持有者可能已在两个临界区之间释放了互斥锁 */
+    if (mutex->owner == NULL || mutex->owner_priority == KEVENT_PRIORITY_IMMED) {
+        irq_unlock(key);
+        return;
+    }
+
+    priority = mutex->owner_priority;
+
+    /* 等待队列按优先级排序，头部的等待事件优先级最高 */
+    if (!kevent_queue_is_empty(&mutex->wait_q)) {
+        wait_priority = KEVENT_PRIORITY(KEVENT_OF_NODE(KEVENT_QUEUE_TOP(&mutex->wait_q)));
+        if (wait_priority > KMUTEX_INHERIT_PRIORITY_MAX) {
+            wait_priority = KMUTEX_INHERIT_PRIORITY_MAX;
+        }
+
+        if (wait_priority > priority) {
+            priority = wait_priority;
+        }
+    }
+
+    kmutex_event_priority_set(mutex->owner, priority);
+
+    irq_unlock(key);
+}
+
+bool kmutex_lock(kmutex_t *mutex, kevent_t *ev)
+{
+    bool queued = false;
+    int key = irq_lock();
+
+    if (mutex->owner == NULL) {
+        mutex->owner = ev;
+        mutex->owner_priority = KEVENT_PRIORITY(ev);
+        irq_unlock(key);
+        return true;
+    }
+
+    /* 持有者再次获取时不能排在自己之后，否则永远无法被唤醒 */
+    if (mutex->owner == ev) {
+        irq_unlock(key);
+        return true;
+    }
+
+    if (!kevent_is_ref(ev)) {
+        kevent_fifo_priority_push(&mutex->wait_q, ev);
+        queued = true;
+    }
+
+    irq_unlock(key);
+
+    if (queued) {
+        kmutex_inherit_update(mutex);
+    }
+
+    return false;
+}
+
+bool kmutex_lock_cancel(kmutex_t *mutex, kevent_t *ev)
+{
+    bool res = false;
+    int key = irq_lock();
+
+    /* 已就绪的事件已成为持有者，不再处于等待队列之中 */
+    if (!kevent_is_ready(ev)) {
+        res = kevent_queue_del_node(&mutex->wait_q, KEVENT_NODE(ev));
+    }
+
+    irq_unlock(key);
+
+    if (res) {
+        kmutex_inherit_update(mutex);
+    }
+
+    return res;
+}
+
+void kmutex_unlock(kmutex_t *mutex)
+{
+    kevent_t *owner;
+    kevent_t *ev = NULL;
+    uint8_t owner_priority;
+    int key = irq_lock();
+
+    /* 互斥锁未被持有 */
+    if (mutex->owner == NULL) {
+        irq_unlock(key);
+        return;
+    }
+
+    owner = mutex->owner;
+    owner_priority = mutex->owner_priority;
+
+    if (kevent_queue_is_empty(&mutex->wait_q)) {
+        mutex->owner = NULL;
+    } else {
+        /* 最高优先级的等待事件成为新的持有者，其余等待事件的优先级均不高于它 */
+        ev = KEVENT_OF_NODE(kevent_queue_pop(&mutex->wait_q));
+        mutex->owner = ev;
+        mutex->owner_priority = KEVENT_PRIORITY(ev);
+    }
+
+    irq_unlock(key);
+
+    /* 以单独的临界区恢复原持有者的优先级 */
+    key = irq_lock();
+    kmutex_event_priority_set(owner, owner_priority);
+    irq_unlock(key);
+
+    /* 在临界区之外触发，立即事件的回调不会延长中断关闭的时间 */
+    if (ev) {
+        kevent_post(ev);
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <os/kring_queue.h>
+#include <arch/irq.h>
+#include <string.h>
+
+/* 读写位置前进一步，取值范围为[0, 2 * msg_nums) */
+static force_inline uint16_t kring_queue_pos_next(kring_queue_t *kring_q, uint16_t pos)
+{
+    pos++;
+    return pos == 2 * kring_q->msg_nums ? 0 : pos;
+}
+
+/* 读写位置对应的消息地址 */
+static force_inline uint8_t *kring_queue_pos_msg(kring_queue_t *kring_q, uint16_t pos)
+{
+    if (pos >= kring_q->msg_nums) {
+        pos -= kring_q->msg_nums;
+    }
+
+    return kring_q->buff + (uint32_t)pos * kring_q->msg_size;
+}
+
+/* 写入一条消息，返回写入后的消息条数，队列满时返回0 */
+static force_inline uint16_t kring_queue_write(kring_queue_t *kring_q, const void *msg)
+{
+    uint16_t head = kring_q->head;
+    uint16_t count;
+
+    count = kring_queue_count(kring_q);
+    if (count >= kring_q->msg_nums) {
+        return 0;
+    }
+
+    memcpy(kring_queue_pos_msg(kring_q, head), msg, kring_q->msg_size);
+
+    /* 消息内容必须在更新写入位置之前写入 */
+    compiler_barrier();
+    kring_q->head = kring_queue_pos_next(kring_q, head);
+
+    count++;
+    if (count > kring_q->high_water) {
+        kring_q->high_water = count;
+    }
+
+    return count;
+}
+
+/* 读取一条消息，队列空时返回false */
+static force_inline bool kring_queue_read(kring_queue_t *kring_q, void *msg)
+{
+    uint16_t tail = kring_q->tail;
+
+    if (tail == kring_q->head) {
+        return false;
+    }
+
+    memcpy(msg, kring_queue_pos_msg(kring_q, tail), kring_q->msg_size);
+
+    /* 消息内容必须在更新读取位置之前读出 */
+    compiler_barrier();
+    kring_q->tail = kring_queue_pos_next(kring_q, tail);
+
+    return true;
+}
+
+bool kring_queue_push(kring_queue_t *kring_q, const void *msg)
+{
+    int key;
+    kevent_t *listen_ev;
+
+    key = irq_lock();
+
+    if (!kring_queue_write(kring_q, msg)) {
+        irq_unlock(key);
+        return false;
+    }
+
+    if (!kevent_queue_is_empty(&kring_q->wait_q)) {
+        listen_ev = KEVENT_OF_NODE(kevent_queue_pop(&kring_q->wait_q));
+        kevent_post(listen_ev);
+    }
+
+    irq_unlock(key);
+    return true;
+}
+
+bool kring_queue_pop(kring_queue_t *kring_q, void *msg, kevent_t *listen_ev)
+{
+    int key;
+    bool res;
+
+    key = irq_lock();
+
+    res = kring_queue_read(kring_q, msg);
+    if (!res && listen_ev && !kevent_is_ref(listen_ev)) {
+        kevent_queue_push(&kring_q->wait_q, KEVENT_NODE(listen_ev));
+    }
+
+    irq_unlock(key);
+    return res;
+}
+
+bool kring_queue_spsc_push(kring_queue_t *kring_q, const void *msg)
+{
+    int key;
+    kevent_t *listen_ev = NULL;
+
+    if (!kring_queue_write(kring_q, msg)) {
+        return false;
+    }
+
+    /* 仅在存在监听事件时才需要关闭中断 */
+    if (!kevent_queue_is_empty(&kring_q->wait_q)) {
+        key = irq_lock();
+
+        if (!kevent_queue_is_empty(&kring_q->wait_q)) {
+            listen_ev = KEVENT_OF_NODE(kevent_queue_pop(&kring_q->wait_q));
+        }
+
+        irq_unlock(key);
+
+        if (listen_ev) {
+            kevent_post(listen_ev);
+        }
+    }
+
+    return true;
+}
+
+bool kring_queue_spsc_pop(kring_queue_t *kring_q, void *msg, kevent_t *listen_ev)
+{
+    int key;
+    bool res;
+
+    if (kring_queue_read(kring_q, msg)) {
+        return true;
+    }
+
+    if (!listen_ev) {
+        return false;
+    }
+
+    /* 队列为空，在关闭中断的情况下再次检查，避免丢失生产者的唤醒 */
+    key = irq_lock();
+
+    res = kring_queue_read(kring_q, msg);
+    if (!res && !kevent_is_ref(listen_ev)) {
+        kevent_queue_push(&kring_q->wait_q, KEVENT_NODE(listen_ev));
+    }
+
+    irq_unlock(key);
+    return res;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <os/ksem.h>
+#include <arch/irq.h>
+
+bool ksem_take(ksem_t *sem, kevent_t *ev)
+{
+    int key = irq_lock();
+
+    if (sem->count) {
+        sem->count--;
+        irq_unlock(key);
+        return true;
+    }
+
+    if (!kevent_is_ref(ev)) {
+        kevent_fifo_priority_push(&sem->wait_q, ev);
+    }
+
+    irq_unlock(key);
+    return false;
+}
+
+bool ksem_take_cancel(ksem_t *sem, kevent_t *ev)
+{
+    bool res = false;
+    int key = irq_lock();
+
+    /* 已就绪的事件已获得信号量，不再处于等待队列之中 */
+    if (!kevent_is_ready(ev)) {
+        res = kevent_queue_del_node(&sem->wait_q, KEVENT_NODE(ev));
+    }
+
+    irq_unlock(key);
+
+    return res;
+}
+
+bool ksem_give(ksem_t *sem)
+{
+    kevent_t *ev;
+    int key = irq_lock();
+
+    /* 信号量直接交给最高优先级的等待事件 */
+    if (!kevent_queue_is_empty(&sem->wait_q)) {
+        ev = KEVENT_OF_NODE(kevent_queue_pop(&sem->wait_q));
+        irq_unlock(key);
+
+        /* 在临界区之外触发，立即事件的回调不会延长中断关闭的时间 */
+        kevent_post(ev);
+        return true;
+    }
+
+    if (sem->limit && sem->count >= sem->limit) {
+        irq_unlock(key);
+        return false;
+    }
+
+    sem->count++;
+    irq_unlock(key);
+    return true;
+}
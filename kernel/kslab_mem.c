@@ -6,20 +6,42 @@
 
 void kslab_mem_init(kslab_mem_t *slab, void *buff, uint32_t blk_nums, uint32_t blk_size)
 {
-    uint8_t *free_node;
-    uint32_t i;
-
-    fifo_init(&slab->wait_q);
+    kevent_queue_init(&slab->wait_q);
 
     /* 初始化空闲块链表 */
     lifo_init(&slab->free_list);
 
-    /* generates a free block list */
-    /* 生成空闲块链表 */
-    free_node = buff;
-    for (i = 0; i < blk_nums; i++) {
-        lifo_push(&slab->free_list, (slist_node_t *)free_node);
-        free_node += blk_size;
+    /* 空闲块链表不在此处生成，分配时从未使用的区域中顺序取出内存块 */
+    slab->unused_blk = buff;
+    slab->blk_end = (uint8_t *)buff + blk_nums * blk_size;
+    slab->blk_size = blk_size;
+}
+
+/* 取出优先级最高的等待者，若其正在带超时地等待，则停止其超时，需要在irq_lock保护下调用 */
+static kslab_event_t *kslab_mem_waiter_pop(kslab_mem_t *slab)
+{
+    kslab_event_t *slab_event = KSLAB_EVENT_OF_NODE(kevent_queue_pop(&slab->wait_q));
+
+    if (slab_event->event.flags & KEVENT_FLAG_TIMED) {
+        ktimeout_stop(&KSLAB_TIMED_EVENT_OF_EVENT(&slab_event->event)->timeout);
+    }
+
+    return slab_event;
+}
+
+/* 若有内存可用，则唤醒等待队列中的一个事件，并解除irq_lock */
+static void kslab_mem_waiter_wakeup_unlock(kslab_mem_t *slab, int key)
+{
+    kslab_event_t *slab_event;
+
+    if (kslab_mem_has_free(slab)) {
+        slab_event = kslab_mem_waiter_pop(slab);
+        slab_event->mem_blk = kslab_mem_blk_take(slab);
+        irq_unlock(key);
+
+        kevent_post(&slab_event->event);
+    } else {
+        irq_unlock(key);
     }
 }
 
@@ -32,15 +54,27 @@ void kslab_mem_wait(kslab_mem_t *slab, kslab_event_t *slab_event)
         kevent_fifo_priority_push(&slab->wait_q, KSLAB_EVENT_EVENT(slab_event));
 
         /* 若有内存可用，则唤醒等待队列中的一个事件 */
-        if (!lifo_is_empty(&slab->free_list)) {
-            slab_event = KSLAB_EVENT_OF_NODE(fifo_pop(&slab->wait_q));
-            slab_event->mem_blk = slist_node_del_next(SLIST_HEAD(&slab->free_list));
-            irq_unlock(key);
-
-            kevent_post(&slab_event->event);
-        } else {
-            irq_unlock(key);
-        }
+        kslab_mem_waiter_wakeup_unlock(slab, key);
+        return;
+    }
+
+    irq_unlock(key);
+}
+
+void kslab_mem_wait_timed(kslab_mem_t *slab, kslab_timed_event_t *timed_event, ktime_tick_t expiry)
+{
+    kslab_event_t *slab_event = &timed_event->slab_event;
+    int key = irq_lock();
+
+    /* 将事件添加到等待列表，并在同一临界区中启动超时 */
+    if (!kevent_is_ref(&slab_event->event)) {
+        slab_event->mem_blk = NULL;
+        kevent_fifo_priority_push(&slab->wait_q, KSLAB_EVENT_EVENT(slab_event));
+        ktimeout_start(&timed_event->timeout, &slab_event->event, &slab->wait_q, expiry);
+
+        /* 若有内存可用，则唤醒等待队列中的一个事件 */
+        kslab_mem_waiter_wakeup_unlock(slab, key);
+        return;
     }
 
     irq_unlock(key);
@@ -52,8 +86,8 @@ void kslab_mem_free(kslab_mem_t *slab, void *mem)
     int key = irq_lock();
 
     /* 通知等待者slab已可用 */
-    if (!fifo_is_empty(&slab->wait_q)) {
-        slab_event = KSLAB_EVENT_OF_EVENT(fifo_pop(&slab->wait_q));
+    if (!kevent_queue_is_empty(&slab->wait_q)) {
+        slab_event = kslab_mem_waiter_pop(slab);
         slab_event->mem_blk = mem;
         irq_unlock(key);
 
@@ -64,4 +98,3 @@ void kslab_mem_free(kslab_mem_t *slab, void *mem)
         irq_unlock(key);
     }
 }
-
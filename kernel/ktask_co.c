@@ -4,12 +4,71 @@
 
 #include <os/ktask_co.h>
 
+#if KTASK_CO_STACK_MONITOR
+/* 所有已注册的任务，任务结束时从列表中移除 */
+static slist_t ktask_co_monitor_list = SLIST_STATIC_INIT(ktask_co_monitor_list);
+
+/* 在异步栈末尾写入金丝雀 */
+static force_inline void ktask_co_stack_canary_set(ktask_co_t *task)
+{
+    if (task->stack.end) {
+        *(uint32_t *)task->stack.end = (uint32_t)KTASK_CO_STACK_CANARY;
+    }
+}
+
+/* 任务是否在监视列表中，以查找列表的方式判断，未初始化的节点也不会被误判，需要在中断关闭时调用 */
+static bool ktask_co_stack_monitor_is_linked(ktask_co_t *task)
+{
+    slist_node_t *node;
+
+    slist_foreach(&ktask_co_monitor_list, node) {
+        if (node == &task->monitor.node) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ktask_co_stack_monitor_register(ktask_co_t *task)
+{
+    int key;
+
+    /* 分段异步栈的金丝雀在分配段时写入 */
+    if (task->seg_pool == NULL) {
+        ktask_co_stack_canary_set(task);
+    }
+
+    key = irq_lock();
+    if (!ktask_co_stack_monitor_is_linked(task)) {
+        slist_node_insert_next(SLIST_HEAD(&ktask_co_monitor_list), &task->monitor.node);
+    }
+    irq_unlock(key);
+}
+
+void ktask_co_stack_monitor_unregister(ktask_co_t *task)
+{
+    int key;
+
+    key = irq_lock();
+    if (slist_del_node(&ktask_co_monitor_list, &task->monitor.node)) {
+        slist_node_init(&task->monitor.node);
+    }
+    irq_unlock(key);
+}
+#endif
+
 void ktask_co_init(ktask_co_t *task, void *stack, size_t stack_size, uint8_t priority)
 {
+#if KTASK_CO_STACK_MONITOR
+    int key;
+#endif
+
     kevent_init(&task->event, (kevent_cb)0, task, priority);
 
     task->stack.start = (uint8_t *)ALIGN_CPU_UP((size_t)stack);
-    task->stack.end = task->stack.start + _SUB_BEZ(stack_size, (size_t)(task->stack.start - (uint8_t *)stack));
+    task->stack.end = task->stack.start + _SUB_BEZ(_SUB_BEZ(stack_size, (size_t)(task->stack.start - (uint8_t *)stack)),
+                                                   KTASK_CO_STACK_CANARY_SIZE);
     task->stack.cur = task->stack.start;
 
     task->ret_val.ptr = NULL;
@@ -17,21 +76,150 @@ void ktask_co_init(ktask_co_t *task, void *stack, size_t stack_size, uint8_t pri
     task->cur_ctx.stack_used = 0;
     task->cur_ctx.bp = 0;
     task->cur_ctx.yield_state = 0;
-    lifo_init(&task->task_end_notify_q);
+    kevent_queue_init(&task->task_end_notify_q);
+    ktimer_init(&task->sleep_timer, ktask_co_sleep_timer_cb, task, priority);
+    task->sleep_timer.expiry = 0;
+    task->seg_pool = NULL;
+    task->asyn_call_failed = false;
+
+#if KTASK_CO_STACK_MONITOR
+    task->monitor.peak = 0;
+    task->monitor.seg_used = 0;
+    task->monitor.overflow = false;
+
+    /* 重新初始化仍在监视列表中的任务时保留其节点，否则链表将出现环 */
+    key = irq_lock();
+    if (!ktask_co_stack_monitor_is_linked(task)) {
+        slist_node_init(&task->monitor.node);
+    }
+    irq_unlock(key);
+
+    ktask_co_stack_monitor_register(task);
+#endif
 }
 
-void ktask_co_asyn_return(ktask_co_t *task)
+void ktask_co_init_seg(ktask_co_t *task, kslab_mem_t *seg_pool, uint8_t priority)
 {
-    lifo_t end_notify_q;
+    ktask_co_init(task, NULL, 0, priority);
+
+    /* 段在首次使用异步栈时分配 */
+    task->stack.start = NULL;
+    task->stack.end = NULL;
+    task->stack.cur = NULL;
+    task->seg_pool = seg_pool;
+}
+
+bool ktask_co_seg_push(ktask_co_t *task)
+{
+    struct ktask_co_seg_s *seg = kslab_mem_alloc(task->seg_pool);
+
+    /* 段分配器已耗尽，由调用者报告失败 */
+    if (seg == NULL) {
+        return false;
+    }
+
+    /* 在新段的头部记录当前段，异步返回越过新段的起始位置时将恢复当前段 */
+    seg->prev_start = task->stack.start;
+    seg->prev_end = task->stack.end;
+    seg->prev_cur = task->stack.cur;
+
+#if KTASK_CO_STACK_MONITOR
+    task->monitor.seg_used += (uint32_t)(task->stack.cur - task->stack.start);
+#endif
+
+    task->stack.start = (uint8_t *)seg + KTASK_CO_SEG_HDR_SIZE;
+    task->stack.end = (uint8_t *)seg + ALIGN_CPU_DOWN(task->seg_pool->blk_size) - KTASK_CO_STACK_CANARY_SIZE;
+    task->stack.cur = task->stack.start;
+
+#if KTASK_CO_STACK_MONITOR
+    ktask_co_stack_canary_set(task);
+#endif
+
+    return true;
+}
+
+/* 归还当前段，并恢复上一个段 */
+static void ktask_co_seg_pop(ktask_co_t *task)
+{
+    struct ktask_co_seg_s *seg = (struct ktask_co_seg_s *)(task->stack.start - KTASK_CO_SEG_HDR_SIZE);
+
+    task->stack.start = seg->prev_start;
+    task->stack.end = seg->prev_end;
+    task->stack.cur = seg->prev_cur;
+
+#if KTASK_CO_STACK_MONITOR
+    task->monitor.seg_used -= (uint32_t)(task->stack.cur - task->stack.start);
+#endif
+
+    kslab_mem_free(task->seg_pool, seg);
+}
+
+/* 任务结束，归还异步栈并通知等待任务结束的事件 */
+static void ktask_co_end(ktask_co_t *task)
+{
+    kevent_queue_t end_notify_q;
     int key;
 
-    if (task->stack.cur >= task->stack.start + KTASK_CO_STACK_CTX_SIZE) {
+    /* 停止未到期的睡眠定时器 */
+    ktimer_stop(&task->sleep_timer);
+
+    /* 归还分段异步栈的所有段 */
+    if (task->seg_pool) {
+        while (task->stack.start) {
+            task->stack.cur = task->stack.start;
+            ktask_co_seg_pop(task);
+        }
+    }
+
+    task->stack.cur = task->stack.start;
+    task->ret_val.ptr = NULL;
+    task->cur_ctx.stack_used = 0;
+    task->cur_ctx.bp = 0;
+    task->cur_ctx.yield_state = 0;
+    KEVENT_CALLBACK(&(task)->event) = (kevent_cb)0;
+
+    /* 结束的任务可能被释放，从监视列表中移除，再次启动时重新注册 */
+    _ktask_co_stack_monitor_unregister(task);
+
+    kevent_queue_init(&end_notify_q);
+
+    key = irq_lock();
+    kevent_queue_nodes_transfer_to(&task->task_end_notify_q, &end_notify_q);
+    irq_unlock(key);
+
+    while (!kevent_queue_is_empty(&end_notify_q)) {
+        /* 异步提交事件可避免在回调中释放task而引起错误 */
+        kevent_post(KEVENT_OF_NODE(kevent_queue_pop(&end_notify_q)));
+    }
+}
+
+/* 异步栈指针位于段的起始位置，且存在上一个段；
+ * 从未分配过段的任务stack.start为NULL，没有段头可读 */
+static force_inline bool ktask_co_seg_is_bottom(ktask_co_t *task)
+{
+    return task->seg_pool &&
+           task->stack.start &&
+           task->stack.cur == task->stack.start &&
+           ((struct ktask_co_seg_s *)(task->stack.start - KTASK_CO_SEG_HDR_SIZE))->prev_start;
+}
+
+void ktask_co_asyn_return(ktask_co_t *task)
+{
+    /* 当前异步函数的栈帧位于新段的起始位置，调用者的上下文位于上一个段 */
+    if (ktask_co_seg_is_bottom(task)) {
+        ktask_co_seg_pop(task);
+    }
+
+    if ((size_t)(task->stack.cur - task->stack.start) >= KTASK_CO_STACK_CTX_SIZE) {
         /* 恢复调用者上下文信息及事件回调 */
         task->stack.cur -= KTASK_CO_STACK_CTX_SIZE;
         task->cur_ctx = *(struct ktask_co_cur_ctx_s *)task->stack.cur;
         KEVENT_CALLBACK(&task->event) = *(kevent_cb *)(task->stack.cur + sizeof(struct ktask_co_cur_ctx_s));
         task->stack.cur -= task->cur_ctx.stack_used;
 
+        /* 被调用者内部失败的调用不影响调用者的判断 */
+        task->asyn_call_failed = false;
+
         KTASK_CO_ASSERT(task->stack.cur >= task->stack.start && task->stack.cur <= task->stack.end);
 
         if (task->cur_ctx.yield_state) {
@@ -41,21 +229,7 @@ void ktask_co_asyn_return(ktask_co_t *task)
     }
     /* 任务结束 */
     else {
-        task->stack.cur = task->stack.start;
-        task->ret_val.ptr = NULL;
-        task->cur_ctx.stack_used = 0;
-        task->cur_ctx.bp = 0;
-        task->cur_ctx.yield_state = 0;
-        KEVENT_CALLBACK(&(task)->event) = (kevent_cb)0;
-
-        key = irq_lock();
-        lifo_nodes_transfer_to(&task->task_end_notify_q, &end_notify_q);
-        irq_unlock(key);
-
-        while (!lifo_is_empty(&end_notify_q)) {
-            /* 异步提交事件可避免在回调中释放task而引起错误 */
-            kevent_post(KEVENT_OF_NODE(lifo_pop(&end_notify_q)));
-        }
+        ktask_co_end(task);
     }
 }
 
@@ -64,20 +238,33 @@ bool ktask_end_wait_cancel(ktask_co_t *task, kevent_t *ev)
     bool res;
     int key = irq_lock();
 
-    if (slist_node_is_del(KEVENT_NODE(ev)) ||
+    if (kevent_node_is_del(KEVENT_NODE(ev)) ||
         kevent_is_ready(ev)) {
         irq_unlock(key);
         return false;
     }
 
-    res = lifo_del_node(&task->task_end_notify_q, KEVENT_NODE(ev));
+    res = kevent_queue_del_node(&task->task_end_notify_q, KEVENT_NODE(ev));
     irq_unlock(key);
     return res;
 }
 
-void ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc, void **pbpd)
+bool ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc, void **pbpd)
 {
+    /* 分段异步栈的当前段无法容纳上下文信息，此时当前栈帧没有异步变量，在新段中保存上下文 */
+    if (task->seg_pool &&
+        (size_t)(task->stack.end - task->stack.cur) < task->cur_ctx.stack_used + KTASK_CO_STACK_CTX_SIZE) {
+        KTASK_CO_ASSERT(task->cur_ctx.stack_used == 0);
+        if (!ktask_co_seg_push(task)) {
+            task->asyn_call_failed = true;
+            return false;
+        }
+    }
+
+    task->asyn_call_failed = false;
+
     KTASK_CO_ASSERT(task->stack.cur + task->cur_ctx.stack_used + KTASK_CO_STACK_CTX_SIZE <= task->stack.end);
+    ktask_co_stack_track(task, task->stack.cur + task->cur_ctx.stack_used + KTASK_CO_STACK_CTX_SIZE);
 
     /* Save current context information and event callback */
     /* 保存当前上下文信息以及事件回调 */
@@ -93,4 +280,219 @@ void ktask_co_asyn_call_prepare(ktask_co_t *task, ktask_co_asyn_routine_t afunc,
     task->cur_ctx.stack_used = 0;
     task->cur_ctx.yield_state = 0;
     KEVENT_CALLBACK(&task->event) = (kevent_cb)afunc;
+
+    return true;
+}
+
+void ktask_co_stack_info_get(ktask_co_t *task, ktask_co_stack_info_t *info)
+{
+    int key = irq_lock();
+
+    info->task = task;
+
+    if (task->seg_pool) {
+        info->size = ALIGN_CPU_DOWN(task->seg_pool->blk_size) - KTASK_CO_SEG_HDR_SIZE - KTASK_CO_STACK_CANARY_SIZE;
+    }
+    else {
+        info->size = (uint32_t)(task->stack.end - task->stack.start);
+    }
+
+    info->depth = (uint32_t)(task->stack.cur - task->stack.start) + task->cur_ctx.stack_used;
+
+#if KTASK_CO_STACK_MONITOR
+    info->depth += task->monitor.seg_used;
+    info->peak = task->monitor.peak;
+    info->overflow = task->monitor.overflow;
+#else
+    info->peak = 0;
+    info->overflow = false;
+#endif
+
+    irq_unlock(key);
+}
+
+void ktask_co_stack_report(ktask_co_stack_report_cb report, void *arg)
+{
+#if KTASK_CO_STACK_MONITOR
+    ktask_co_stack_info_t info;
+    slist_node_t *node;
+    uint32_t idx;
+    uint32_t i;
+    int key;
+
+    /* 任务可能在报告期间结束并被释放，每次在中断关闭时按序号重新查找并复制信息，
+     * 在中断开启时调用回调；期间注册或移除的任务可能导致个别任务被遗漏或重复报告 */
+    for (idx = 0; ; idx++) {
+        i = 0;
+
+        key = irq_lock();
+        slist_foreach(&ktask_co_monitor_list, node) {
+            if (i++ == idx) {
+                ktask_co_stack_info_get(slist_entry(node, ktask_co_t, monitor.node), &info);
+                break;
+            }
+        }
+        irq_unlock(key);
+
+        if (node == SLIST_HEAD(&ktask_co_monitor_list)) {
+            break;
+        }
+
+        report(&info, arg);
+    }
+#else
+    (void)report;
+    (void)arg;
+#endif
+}
+
+/* 子操作完成，KTASK_CO_JOIN_ALL模式下所有子操作完成时，或KTASK_CO_JOIN_ANY模式下
+ * 第一个子操作完成时，唤醒正在等待的父协程 */
+static void ktask_co_join_entry_cb(void *data, kevent_t *ev)
+{
+    ktask_co_join_t *join = (ktask_co_join_t *)data;
+    ktask_co_join_entry_t *entry = container_of(ev, ktask_co_join_entry_t, event);
+    uint8_t idx = (uint8_t)(entry - join->entries);
+    bool wakeup;
+    uint8_t i;
+    int key;
+
+    key = irq_lock();
+
+    /* 子操作组已完成，忽略在取消之前已触发的子操作 */
+    if (join->pending == 0 || (join->done & BIT(idx))) {
+        irq_unlock(key);
+        return;
+    }
+
+    join->done |= BIT(idx);
+    join->pending--;
+
+    if (join->first < 0) {
+        join->first = idx;
+    }
+
+    if (join->mode == KTASK_CO_JOIN_ANY) {
+        join->pending = 0;
+    }
+
+    wakeup = join->pending == 0 && join->waiting;
+    if (wakeup) {
+        join->waiting = 0;
+    }
+
+    irq_unlock(key);
+
+    /* 取消其他未完成的子操作 */
+    if (join->mode == KTASK_CO_JOIN_ANY) {
+        for (i = 0; i < join->nums; i++) {
+            entry = &join->entries[i];
+            if (join->done & BIT(i)) {
+                continue;
+            }
+
+            if (entry->cancel) {
+                entry->cancel(&entry->event, entry->cancel_arg);
+            }
+
+            if (kevent_is_ready(&entry->event)) {
+                kevent_cancel(&entry->event);
+            }
+        }
+    }
+
+    if (wakeup) {
+        kevent_post(&join->task->event);
+    }
+}
+
+void ktask_co_join_init(ktask_co_join_t *join, ktask_co_t *task,
+                        ktask_co_join_entry_t *entries, uint8_t nums, uint8_t mode)
+{
+    uint8_t i;
+
+    KTASK_CO_ASSERT(nums <= KTASK_CO_JOIN_NUMS_MAX);
+
+    join->task = task;
+    join->entries = entries;
+    join->done = 0;
+    join->nums = nums;
+    join->pending = nums;
+    join->mode = mode;
+    join->waiting = 0;
+    join->first = -1;
+
+    for (i = 0; i < nums; i++) {
+        kevent_init(&entries[i].event, ktask_co_join_entry_cb, join, KEVENT_PRIORITY(&task->event));
+        entries[i].join = join;
+        entries[i].cancel = NULL;
+        entries[i].cancel_arg = NULL;
+    }
+}
+
+bool ktask_co_join_wait(ktask_co_join_t *join)
+{
+    int key = irq_lock();
+
+    if (join->pending == 0) {
+        irq_unlock(key);
+        return true;
+    }
+
+    join->waiting = 1;
+    irq_unlock(key);
+    return false;
+}
+
+bool ktask_co_abort(ktask_co_t *task)
+{
+    int key;
+
+    key = irq_lock();
+
+    if (ktask_co_is_end(task)) {
+        irq_unlock(key);
+        return true;
+    }
+
+    /* 事件处于就绪队列或睡眠定时器之中时可以撤销，处于其他等待队列时无法撤销 */
+    if (kevent_is_ready(&task->event)) {
+        kevent_cancel(&task->event);
+    } else if (!kevent_node_is_del(KEVENT_NODE(&task->event)) ||
+               kevent_node_is_del(KTIMER_NODE(&task->sleep_timer))) {
+        irq_unlock(key);
+        return false;
+    }
+
+    /* 停止睡眠定时器，包括已到期但还未调度的定时器事件 */
+    ktimer_stop(&task->sleep_timer);
+
+    irq_unlock(key);
+
+    ktask_co_end(task);
+    return true;
+}
+
+void ktask_co_join_task_cancel(kevent_t *ev, void *arg)
+{
+    ktask_co_t *child = (ktask_co_t *)arg;
+
+    ktask_end_wait_cancel(child, ev);
+
+    /* 调度器只让优先级更高的事件抢占，子协程的事件优先级不低于子操作事件时，
+     * 子操作回调不可能抢占正在运行的子协程，可以安全地终止；
+     * 否则子协程可能被抢占于回调之中，只撤销监听，由子协程运行至结束 */
+    if (KEVENT_PRIORITY(ev) != KEVENT_PRIORITY_IMMED &&
+        KEVENT_PRIORITY(&child->event) != KEVENT_PRIORITY_IMMED &&
+        KEVENT_PRIORITY(&child->event) >= KEVENT_PRIORITY(ev)) {
+        ktask_co_abort(child);
+    }
+}
+
+void ktask_co_sleep_timer_cb(void *data, kevent_t *ev)
+{
+    ktask_co_t *task = (ktask_co_t *)data;
+
+    (void)ev;
+    KEVENT_CALLBACK(&task->event)(task, &task->event);
 }
@@ -6,45 +6,65 @@
 #include <arch/irq.h>
 
 /* 定时器队列 */
-static fifo_t timers = FIFO_STATIC_INIT(timers);
+static kevent_queue_t timers = KEVENT_QUEUE_STATIC_INIT(timers);
+
+#if KEVENT_NODE_PHEAP
+/* 定时器堆的排序回调，到期时间早的定时器在前，相同到期时间按启动顺序排序 */
+static bool ktimer_node_expiry_before(const pheap_node_t *a, const pheap_node_t *b)
+{
+    return ((const ktimer_event_t *)a)->expiry < ((const ktimer_event_t *)b)->expiry;
+}
+
+#define ktimer_queue_pop()              pheap_pop(&timers, ktimer_node_expiry_before)
+#define ktimer_queue_del_node(node)     pheap_del_node(&timers, (node), ktimer_node_expiry_before)
+#else
+#define ktimer_queue_pop()              kevent_queue_pop(&timers)
+#define ktimer_queue_del_node(node)     kevent_queue_del_node(&timers, (node))
+#endif /* KEVENT_NODE_PHEAP */
 
 /* 启动定时器，在expiry时将会触发 */
 void ktimer_start_expiry(ktimer_event_t *timer, ktime_tick_t expiry)
 {
     int key;
+#if !KEVENT_NODE_PHEAP
     ktimer_event_t *find;
-    slist_node_t *prev_node;
-    slist_node_t *cur_node;
+    kevent_node_t *prev_node;
+    kevent_node_t *cur_node;
+#endif
     
     expiry = expiry == 0 ? 1 : expiry;
 
     key = irq_lock();
 
     /* ktimer处于队列中，无法被重复插入 */
-    if (!slist_node_is_del(KTIMER_NODE(timer))) {
+    if (!kevent_node_is_del(KTIMER_NODE(timer))) {
         irq_unlock(key);
         return;
     }
 
     timer->expiry = expiry;
 
+#if KEVENT_NODE_PHEAP
+    pheap_push(&timers, KTIMER_NODE(timer), ktimer_node_expiry_before);
+#else
     /* 先查看是否可以插入到队列尾部 */
-    find = KTIMER_OF_NODE(FIFO_TAIL(&timers));
-    if (fifo_is_empty(&timers) || find->expiry <= expiry) {
-        fifo_push(&timers, KTIMER_NODE(timer));
+    find = KTIMER_OF_NODE(KEVENT_QUEUE_TAIL(&timers));
+    if (kevent_queue_is_empty(&timers) || find->expiry <= expiry) {
+        kevent_queue_push(&timers, KTIMER_NODE(timer));
     } else {
         /* 遍历定时器列表，将定时器插入到合适的位置 */
-        slist_foreach_record_prev(FIFO_LIST(&timers), cur_node, prev_node) {
+        kevent_queue_foreach_record_prev(&timers, cur_node, prev_node) {
             find = KTIMER_OF_NODE(cur_node);
             if (find->expiry > expiry) {
-                fifo_node_insert_next(&timers, prev_node, KTIMER_NODE(timer));
+                kevent_queue_insert_next(&timers, prev_node, KTIMER_NODE(timer));
                 break;
             }
         }
     }
+#endif /* KEVENT_NODE_PHEAP */
 
     /* 若timer被插到头部，则更新到期时间 */
-    if (KTIMER_NODE(timer) == FIFO_TOP(&timers)) {
+    if (KTIMER_NODE(timer) == KEVENT_QUEUE_TOP(&timers)) {
         drv_ktimer_set_expiry(expiry);
     }
 
@@ -60,15 +80,15 @@ void sys_ktimer_timeout_check(ktime_tick_t now)
 
     key = irq_lock();
 
-    while (!fifo_is_empty(&timers)) {
-        timer = KTIMER_OF_NODE(FIFO_TOP(&timers));
+    while (!kevent_queue_is_empty(&timers)) {
+        timer = KTIMER_OF_NODE(KEVENT_QUEUE_TOP(&timers));
         /* 未超时 */
         if (now < timer->expiry) {
             break;
         }
         update = true;
 
-        fifo_pop(&timers);
+        ktimer_queue_pop();
         irq_unlock(key);
 
         /* 提交这个定时器事件 */
@@ -79,8 +99,8 @@ void sys_ktimer_timeout_check(ktime_tick_t now)
 
     if (update) {
         expiry = 0;
-        if (!fifo_is_empty(&timers)) {
-            expiry = KTIMER_OF_NODE(FIFO_TOP(&timers))->expiry;
+        if (!kevent_queue_is_empty(&timers)) {
+            expiry = KTIMER_OF_NODE(KEVENT_QUEUE_TOP(&timers))->expiry;
         }
 
         drv_ktimer_set_expiry(expiry);
@@ -95,8 +115,8 @@ ktime_tick_t sys_ktimer_earliest_expiry(void)
     ktime_tick_t expiry = 0;
     int key = irq_lock();
 
-    if (!fifo_is_empty(&timers)) {
-        expiry = KTIMER_OF_NODE(FIFO_TOP(&timers))->expiry;
+    if (!kevent_queue_is_empty(&timers)) {
+        expiry = KTIMER_OF_NODE(KEVENT_QUEUE_TOP(&timers))->expiry;
     }
 
     irq_unlock(key);
@@ -107,10 +127,10 @@ ktime_tick_t sys_ktimer_earliest_expiry(void)
 void ktimer_stop(ktimer_event_t *timer)
 {
     ktime_tick_t new_expiry;
-    slist_node_t *top;
+    kevent_node_t *top;
     int key = irq_lock();
 
-    if (slist_node_is_del(KTIMER_NODE(timer))) {
+    if (kevent_node_is_del(KTIMER_NODE(timer))) {
         goto exit;
     }
 
@@ -119,13 +139,13 @@ void ktimer_stop(ktimer_event_t *timer)
         goto exit;
     }
 
-    top = FIFO_TOP(&timers);
-    fifo_del_node(&timers, KTIMER_NODE(timer));
+    top = KEVENT_QUEUE_TOP(&timers);
+    ktimer_queue_del_node(KTIMER_NODE(timer));
 
     if (top == KTIMER_NODE(timer)) {
         new_expiry = 0;
-        if (!fifo_is_empty(&timers)) {
-            new_expiry = KTIMER_OF_NODE(FIFO_TOP(&timers))->expiry;
+        if (!kevent_queue_is_empty(&timers)) {
+            new_expiry = KTIMER_OF_NODE(KEVENT_QUEUE_TOP(&timers))->expiry;
         }
 
         drv_ktimer_set_expiry(new_expiry);
@@ -134,3 +154,53 @@ void ktimer_stop(ktimer_event_t *timer)
 exit:
     irq_unlock(key);
 }
+
+/* 等待超时 */
+static void ktimeout_on_expiry(void *cb_data, kevent_t *e)
+{
+    ktimeout_t *timeout = (ktimeout_t *)cb_data;
+    kevent_t *waiter = timeout->waiter;
+    int key = irq_lock();
+
+    (void)e;
+
+    /* 等待者已被唤醒 */
+    if (!(waiter->flags & KEVENT_FLAG_TIMED)) {
+        irq_unlock(key);
+        return;
+    }
+
+    waiter->flags &= ~KEVENT_FLAG_TIMED;
+    kevent_queue_del_node(timeout->wait_q, KEVENT_NODE(waiter));
+    timeout->status = KWAIT_TIMEOUT;
+
+    irq_unlock(key);
+
+    kevent_post(waiter);
+}
+
+void ktimeout_start(ktimeout_t *timeout, kevent_t *waiter, kevent_queue_t *wait_q, ktime_tick_t expiry)
+{
+    int key = irq_lock();
+
+    timeout->waiter = waiter;
+    timeout->wait_q = wait_q;
+    timeout->status = KWAIT_OK;
+    waiter->flags |= KEVENT_FLAG_TIMED;
+
+    ktimer_init(&timeout->timer, ktimeout_on_expiry, timeout, KEVENT_PRIORITY_IMMED);
+    ktimer_start_expiry(&timeout->timer, expiry);
+
+    irq_unlock(key);
+}
+
+void ktimeout_stop(ktimeout_t *timeout)
+{
+    int key = irq_lock();
+
+    timeout->waiter->flags &= ~KEVENT_FLAG_TIMED;
+    timeout->status = KWAIT_OK;
+    ktimer_stop(&timeout->timer);
+
+    irq_unlock(key);
+}
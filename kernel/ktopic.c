@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <os/ktopic.h>
+#include <arch/irq.h>
+
+void ktopic_msg_ref(void *msg)
+{
+    int key = irq_lock();
+
+    KTOPIC_BLK_OF_MSG(msg)->ref++;
+
+    irq_unlock(key);
+}
+
+void ktopic_msg_release(ktopic_t *topic, void *msg)
+{
+    ktopic_msg_hdr_t *hdr = KTOPIC_BLK_OF_MSG(msg);
+    uint32_t ref;
+    int key = irq_lock();
+
+    ref = --hdr->ref;
+
+    irq_unlock(key);
+
+    /* 最后一个引用被释放 */
+    if (ref == 0) {
+        kslab_mem_free(topic->pool, hdr);
+    }
+}
+
+void ktopic_subscribe(ktopic_t *topic, ktopic_sub_t *sub)
+{
+    int key;
+
+    KTOPIC_ASSERT(sub->depth > 0);
+
+    if (sub->depth == 0) {
+        return;
+    }
+
+    key = irq_lock();
+
+    if (slist_node_is_del(&sub->node)) {
+        slist_node_insert_next(SLIST_HEAD(&topic->subs), &sub->node);
+    }
+
+    irq_unlock(key);
+}
+
+void ktopic_unsubscribe(ktopic_t *topic, ktopic_sub_t *sub)
+{
+    void *msg;
+    int key = irq_lock();
+
+    slist_del_node(&topic->subs, &sub->node);
+
+    irq_unlock(key);
+
+    while ((msg = ktopic_sub_take(sub)) != NULL) {
+        ktopic_msg_release(topic, msg);
+    }
+}
+
+void ktopic_publish(ktopic_t *topic, void *msg)
+{
+    ktopic_sub_t *sub;
+    ktopic_msg_hdr_t *old;
+    kevent_queue_t wakeups;
+    slist_t dropped;
+    slist_node_t *blk;
+    uint16_t pos;
+    int key;
+
+    /* 唤醒与释放在临界区之外进行，立即事件的回调不会延长中断关闭的时间 */
+    kevent_queue_init(&wakeups);
+    slist_init(&dropped);
+
+    key = irq_lock();
+
+    slist_foreach_entry(&topic->subs, sub, node) {
+        /* first + count最大为2 * depth - 1，超出uint8_t的范围 */
+        pos = (uint16_t)sub->first + sub->count;
+        if (pos >= sub->depth) {
+            pos -= sub->depth;
+        }
+
+        /* 消息环已满，丢弃最早的消息，不再被引用的内存块借用其头部链接到dropped中 */
+        if (sub->count == sub->depth) {
+            old = KTOPIC_BLK_OF_MSG(sub->slots[sub->first]);
+            if (--old->ref == 0) {
+                slist_node_insert_next(SLIST_HEAD(&dropped), (slist_node_t *)old);
+            }
+
+            sub->first = sub->first + 1 == sub->depth ? 0 : sub->first + 1;
+            sub->dropped++;
+        } else {
+            sub->count++;
+        }
+
+        KTOPIC_BLK_OF_MSG(msg)->ref++;
+        sub->slots[pos] = msg;
+
+        /* 已就绪或已在wakeups中的事件无需再次提交 */
+        if (sub->listen_ev && kevent_node_is_del(KEVENT_NODE(sub->listen_ev))) {
+            kevent_queue_push(&wakeups, KEVENT_NODE(sub->listen_ev));
+        }
+    }
+
+    irq_unlock(key);
+
+    while (!kevent_queue_is_empty(&wakeups)) {
+        kevent_post(KEVENT_OF_NODE(kevent_queue_pop(&wakeups)));
+    }
+
+    while (!slist_is_empty(&dropped)) {
+        blk = slist_node_del_next(SLIST_HEAD(&dropped));
+        kslab_mem_free(topic->pool, blk);
+    }
+
+    /* 释放发布者持有的引用 */
+    ktopic_msg_release(topic, msg);
+}
+
+void *ktopic_sub_take(ktopic_sub_t *sub)
+{
+    void *msg = NULL;
+    int key = irq_lock();
+
+    if (sub->count) {
+        msg = sub->slots[sub->first];
+        sub->first = sub->first + 1 == sub->depth ? 0 : sub->first + 1;
+        sub->count--;
+    }
+
+    irq_unlock(key);
+    return msg;
+}
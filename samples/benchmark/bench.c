@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+
+/* 连续两次读取计数器的最小差值，作为计数器自身的开销 */
+static uint32_t bench_overhead;
+
+/* 是否已输出过测试项，用于在JSON数组中插入分隔符 */
+static bool bench_reported;
+
+/* 进入测试前的栈指针，用于计算各优先级组的栈使用量 */
+static uintptr_t bench_stack_base;
+
+static void bench_overhead_calibrate(void)
+{
+    uint32_t start, end;
+    uint32_t i;
+
+    bench_overhead = UINT32_MAX;
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        end = bench_cycles();
+
+        if (end - start < bench_overhead) {
+            bench_overhead = end - start;
+        }
+    }
+}
+
+uint32_t bench_elapsed(uint32_t start, uint32_t end)
+{
+    uint32_t elapsed = end - start;
+
+    return elapsed > bench_overhead ? elapsed - bench_overhead : 0;
+}
+
+void bench_stat_begin(bench_stat_t *stat, const char *name, uint32_t param)
+{
+    stat->name = name;
+    stat->param = param;
+    stat->samples = 0;
+    stat->min = UINT32_MAX;
+    stat->max = 0;
+    stat->sum = 0;
+}
+
+void bench_stat_add(bench_stat_t *stat, uint32_t cycles, uint32_t batch)
+{
+    uint32_t per_op = (cycles + batch / 2) / batch;
+
+    if (per_op < stat->min) {
+        stat->min = per_op;
+    }
+
+    if (per_op > stat->max) {
+        stat->max = per_op;
+    }
+
+    stat->sum += per_op;
+    stat->samples++;
+}
+
+void bench_stat_report(bench_stat_t *stat)
+{
+    uint32_t avg = stat->samples ? (uint32_t)(stat->sum / stat->samples) : 0;
+
+    printf("%s\n    {\"name\": \"%s\", \"param\": %lu, \"samples\": %lu, "
+           "\"min\": %lu, \"avg\": %lu, \"max\": %lu}",
+           bench_reported ? "," : "",
+           stat->name,
+           (unsigned long)stat->param,
+           (unsigned long)stat->samples,
+           (unsigned long)(stat->samples ? stat->min : 0),
+           (unsigned long)avg,
+           (unsigned long)stat->max);
+
+    bench_reported = true;
+}
+
+#if KEVENT_STACK_MONITOR
+/* 输出各优先级组的调度嵌套层数与相对于测试开始时的栈使用量 */
+static void bench_stack_report(void)
+{
+    kevent_stack_info_t info;
+    uint8_t i;
+
+    printf(",\n  \"stack\": [");
+    for (i = 0; i < KEVENT_PRIORITY_GROUP_COUNT; i++) {
+        kevent_stack_info_get(i, &info);
+        printf("%s\n    {\"group\": %u, \"depth_peak\": %u, \"used\": %lu}",
+               i ? "," : "",
+               (unsigned)i,
+               (unsigned)info.depth_peak,
+               (unsigned long)(info.sp_min ? bench_stack_base - info.sp_min : 0));
+    }
+    printf("\n  ]");
+}
+#endif /* KEVENT_STACK_MONITOR */
+
+#if IRQ_LOCK_PROFILE
+/* 临界区时长统计使用测试的计数器 */
+uint32_t irq_lock_profile_cycles_get(void)
+{
+    return bench_cycles();
+}
+
+/* 输出最长的临界区与irq_lock的调用位置 */
+static void bench_irq_lock_report(void)
+{
+    irq_lock_profile_t profile;
+    uint32_t i;
+
+    irq_lock_profile_get(&profile);
+
+    printf(",\n  \"irq_lock\": {\"count\": %lu, \"sections\": [", (unsigned long)profile.count);
+    for (i = 0; i < profile.nums; i++) {
+        printf("%s\n    {\"site\": \"%s:%lu\", \"max\": %lu}",
+               i ? "," : "",
+               profile.sections[i].file,
+               (unsigned long)profile.sections[i].line,
+               (unsigned long)bench_elapsed(0, profile.sections[i].cycles));
+    }
+    printf("\n  ]}");
+}
+#endif /* IRQ_LOCK_PROFILE */
+
+int main(void)
+{
+    bench_stack_base = arch_stack_pointer_get();
+
+    bench_port_init();
+    bench_overhead_calibrate();
+    irq_lock_profile_reset();
+
+    printf("{\n");
+    printf("  \"target\": \"%s\",\n", bench_target);
+    printf("  \"unit\": \"%s\",\n", bench_unit);
+    printf("  \"batch\": %d,\n", BENCH_BATCH);
+    printf("  \"overhead\": %lu,\n", (unsigned long)bench_overhead);
+    printf("  \"config\": {\"KEVENT_NODE_DLIST\": %d, \"KEVENT_NODE_PHEAP\": %d, "
+           "\"KEVENT_IRQ_GROUP_NUMS\": %d, \"KEVENT_STACK_MONITOR\": %d, "
+           "\"BP_USE_COMPUTED_GOTO\": %d, \"KTASK_CO_STACK_MONITOR\": %d, "
+           "\"IRQ_LOCK_PROFILE\": %d},\n",
+           KEVENT_NODE_DLIST, KEVENT_NODE_PHEAP, KEVENT_IRQ_GROUP_NUMS, KEVENT_STACK_MONITOR,
+           BP_USE_COMPUTED_GOTO, KTASK_CO_STACK_MONITOR, IRQ_LOCK_PROFILE);
+    printf("  \"results\": [");
+
+    bench_cases_run();
+
+    printf("\n  ]");
+
+#if KEVENT_STACK_MONITOR
+    bench_stack_report();
+#endif
+
+#if IRQ_LOCK_PROFILE
+    bench_irq_lock_report();
+#endif
+
+    printf("\n}\n");
+
+    bench_exit(0);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <os/kernel.h>
+
+/* 每个样本连续执行的操作次数，结果为单次操作的平均值 */
+#ifndef BENCH_BATCH
+#define BENCH_BATCH         64
+#endif
+
+/* 每个测试项的样本个数 */
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       200
+#endif
+
+/*********************************************************
+ *@类型说明：
+ ***一个测试项的统计结果，以bench_cycles的计数单位记录
+ *********************************************************/
+typedef struct bench_stat_s {
+    /* 测试项名称 */
+    const char *name;
+
+    /* 测试参数，如队列长度、定时器个数，无参数时为0 */
+    uint32_t param;
+
+    /* 样本个数 */
+    uint32_t samples;
+
+    /* 最小值、最大值与总和 */
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} bench_stat_t;
+
+/***********************************
+ * 平台移植接口，由port目录下的文件实现
+ ***********************************/
+
+/* 平台名称，写入结果的target字段 */
+extern const char *const bench_target;
+
+/* bench_cycles的计数单位，写入结果的unit字段 */
+extern const char *const bench_unit;
+
+/* 初始化计数器等平台资源 */
+void bench_port_init(void);
+
+/* 读取自由运行的计数器，只使用两次读取之间的差值 */
+uint32_t bench_cycles(void);
+
+/* 等待已提交的事件被调度，有抢占的平台上事件已在提交时执行，无需任何操作 */
+void bench_dispatch(void);
+
+/* 输出结果后结束运行 */
+void bench_exit(int code);
+
+/* 触发外部中断，在中断返回之后返回 */
+void bench_irq_raise(uint32_t irqn);
+
+/* 在抢占调度的事件回调末尾调用，关闭中断并挂起外部中断后返回，
+ * 中断在抢占程序恢复被抢占的上下文、重新打开中断时进入 */
+void bench_irq_raise_on_return(uint32_t irqn);
+
+/* 浮点现场的嵌套抢占：线程设置全部浮点寄存器后触发中断，中断提交的事件中再触发嵌套的中断，
+ * fp_event为false时事件不使用浮点而嵌套的中断使用浮点，为true时相反，
+ * 线程与事件在中断返回后检查各自的浮点寄存器，被破坏时由平台报告错误并结束运行；
+ * 返回false表示平台没有浮点单元，不进行测试 */
+bool bench_fp_preempt(bool fp_event);
+
+/* 中断提交事件测试使用的中断号，分别对应手写的中断处理程序与KIRQ_TABLE_DEFINE生成的处理程序 */
+#define BENCH_IRQN_HAND     28
+#define BENCH_IRQN_STUB     29
+
+void bench_irq_hand_handler(void);
+void bench_irq_stub_handler(void);
+
+/***********************************
+ * 统计与结果输出
+ ***********************************/
+
+/* 开始一个测试项 */
+void bench_stat_begin(bench_stat_t *stat, const char *name, uint32_t param);
+
+/* 添加一个样本，cycles为batch次操作的总耗时，已扣除计数器自身的开销 */
+void bench_stat_add(bench_stat_t *stat, uint32_t cycles, uint32_t batch);
+
+/* 以JSON对象的形式输出测试项 */
+void bench_stat_report(bench_stat_t *stat);
+
+/* 扣除计数器读取开销后的差值 */
+uint32_t bench_elapsed(uint32_t start, uint32_t end);
+
+/* 所有测试项，由bench_cases.c实现 */
+void bench_cases_run(void);
+
+#endif /* __BENCH_H__ */
@@ -0,0 +1,648 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include "bench.h"
+
+/* 测量语句stmt，共BENCH_SAMPLES个样本，每个样本连续执行BENCH_BATCH次 */
+#define BENCH_RUN(stat, stmt)                                                   \
+    do {                                                                        \
+        uint32_t _sample, _op, _start;                                          \
+        for (_sample = 0; _sample < BENCH_SAMPLES; _sample++) {                 \
+            _start = bench_cycles();                                            \
+            for (_op = 0; _op < BENCH_BATCH; _op++) {                           \
+                stmt;                                                           \
+            }                                                                   \
+            bench_stat_add((stat), bench_elapsed(_start, bench_cycles()),       \
+                           BENCH_BATCH);                                        \
+        }                                                                       \
+    } while (0)
+
+/* 容器测试的最大节点个数 */
+#define BENCH_NODES_MAX     64
+
+/* 定时器测试的最大活动定时器个数 */
+#define BENCH_TIMERS_MAX    128
+
+/* 定时器测试的起始到期时刻，测试期间不会到期 */
+#define BENCH_TIMER_BASE    ((ktime_tick_t)1 << 40)
+
+/* 消息队列批量取出测试的消息个数 */
+#define BENCH_DRAIN_NUMS    16
+
+/* 测试使用的消息 */
+typedef struct bench_msg_s {
+    slist_node_t node;
+    uint32_t data[3];
+} bench_msg_t;
+
+/* 带排序键的配对堆节点 */
+typedef struct bench_pheap_node_s {
+    pheap_node_t node;
+    uint32_t key;
+} bench_pheap_node_t;
+
+static slist_node_t bench_nodes[BENCH_NODES_MAX];
+static dlist_node_t bench_dnodes[BENCH_NODES_MAX];
+static bench_pheap_node_t bench_pnodes[BENCH_NODES_MAX];
+static ktimer_event_t bench_timers[BENCH_TIMERS_MAX + 1];
+static bench_msg_t bench_msgs[BENCH_DRAIN_NUMS];
+
+KSLAB_DEFINE_STATIC(bench_slab, bench_msg_t, 4);
+KRING_QUEUE_DEFINE_STATIC(bench_ring, bench_msg_t, 4);
+KTASK_CO_DEFINE_STATIC(bench_task, 128, KEVENT_PRIORITY_IMMED);
+
+/* 分段异步栈的段 */
+typedef struct bench_seg_s {
+    uint8_t blk[KTASK_CO_SEG_HDR_SIZE + 64];
+} bench_seg_t;
+
+KSLAB_DEFINE_STATIC(bench_seg_pool, bench_seg_t, 2);
+KTASK_CO_SEG_DEFINE_STATIC(bench_seg_task, &bench_seg_pool, KEVENT_PRIORITY_IMMED);
+
+static kmsg_queue_t bench_kmsg_q = KMSG_QUEUE_STATIC_INIT(bench_kmsg_q);
+static kevent_t bench_listen_ev;
+
+/* 事件回调中记录的结束时刻 */
+static uint32_t bench_end;
+
+/* 协程测试中已完成的异步调用次数 */
+static uint32_t bench_co_calls;
+
+/***********************************
+ * 容器
+ ***********************************/
+
+/* 建立n个节点的单链表，返回最后一个节点的前驱 */
+static slist_node_t *bench_slist_build(slist_t *list, uint32_t n)
+{
+    uint32_t i;
+
+    slist_init(list);
+    for (i = n; i > 0; i--) {
+        slist_node_insert_next(SLIST_HEAD(list), &bench_nodes[i - 1]);
+    }
+
+    return n > 1 ? &bench_nodes[n - 2] : SLIST_HEAD(list);
+}
+
+static void bench_slist(uint32_t n)
+{
+    bench_stat_t stat;
+    slist_t list;
+    slist_node_t *prev = bench_slist_build(&list, n);
+    slist_node_t *last = &bench_nodes[n - 1];
+    slist_node_t extra;
+
+    slist_node_init(&extra);
+    bench_stat_begin(&stat, "slist.insert_del_head", n);
+    BENCH_RUN(&stat, (slist_node_insert_next(SLIST_HEAD(&list), &extra),
+                      slist_node_del_next(SLIST_HEAD(&list))));
+    bench_stat_report(&stat);
+
+    /* 删除最后一个节点需要遍历整个链表，再插回原来的位置 */
+    bench_stat_begin(&stat, "slist.del_node", n);
+    BENCH_RUN(&stat, (slist_del_node(&list, last),
+                      slist_node_insert_next(prev, last)));
+    bench_stat_report(&stat);
+}
+
+static void bench_fifo(uint32_t n)
+{
+    bench_stat_t stat;
+    fifo_t fifo;
+    uint32_t i;
+
+    fifo_init(&fifo);
+    for (i = 0; i < n; i++) {
+        slist_node_init(&bench_nodes[i]);
+        fifo_push(&fifo, &bench_nodes[i]);
+    }
+
+    bench_stat_begin(&stat, "fifo.pop_push", n);
+    BENCH_RUN(&stat, fifo_push(&fifo, fifo_pop(&fifo)));
+    bench_stat_report(&stat);
+
+    /* 删除队尾节点需要遍历整个队列，再放回队尾 */
+    bench_stat_begin(&stat, "fifo.del_node", n);
+    BENCH_RUN(&stat, (fifo_del_node(&fifo, FIFO_TAIL(&fifo)),
+                      fifo_push(&fifo, &bench_nodes[(n - 1 + _op) % n])));
+    bench_stat_report(&stat);
+}
+
+static void bench_lifo(uint32_t n)
+{
+    bench_stat_t stat;
+    lifo_t lifo;
+    slist_node_t *prev = bench_slist_build(LIFO_LIST(&lifo), n);
+    slist_node_t *last = &bench_nodes[n - 1];
+    slist_node_t extra;
+
+    slist_node_init(&extra);
+    bench_stat_begin(&stat, "lifo.push_pop", n);
+    BENCH_RUN(&stat, (lifo_push(&lifo, &extra), lifo_pop(&lifo)));
+    bench_stat_report(&stat);
+
+    bench_stat_begin(&stat, "lifo.del_node", n);
+    BENCH_RUN(&stat, (lifo_del_node(&lifo, last),
+                      lifo_node_insert_next(prev, last)));
+    bench_stat_report(&stat);
+}
+
+static void bench_dlist(uint32_t n)
+{
+    bench_stat_t stat;
+    dlist_t list;
+    uint32_t i;
+
+    dlist_init(&list);
+    for (i = 0; i < n; i++) {
+        dlist_node_init(&bench_dnodes[i]);
+        dlist_push(&list, &bench_dnodes[i]);
+    }
+
+    /* 删除任意节点为O(1)，与节点个数无关 */
+    bench_stat_begin(&stat, "dlist.del_node", n);
+    BENCH_RUN(&stat, (dlist_node_del(&bench_dnodes[0]),
+                      dlist_push(&list, &bench_dnodes[0])));
+    bench_stat_report(&stat);
+}
+
+static bool bench_pheap_before(const pheap_node_t *a, const pheap_node_t *b)
+{
+    return ((const bench_pheap_node_t *)a)->key < ((const bench_pheap_node_t *)b)->key;
+}
+
+static void bench_pheap(uint32_t n)
+{
+    bench_stat_t stat;
+    pheap_t heap;
+    uint32_t i;
+
+    pheap_init(&heap);
+    for (i = 0; i < n; i++) {
+        bench_pnodes[i].key = (i * 7) % n;
+        pheap_node_init(&bench_pnodes[i].node);
+        pheap_push(&heap, &bench_pnodes[i].node, bench_pheap_before);
+    }
+
+    bench_stat_begin(&stat, "pheap.pop_push", n);
+    BENCH_RUN(&stat, pheap_push(&heap, pheap_pop(&heap, bench_pheap_before), bench_pheap_before));
+    bench_stat_report(&stat);
+}
+
+/***********************************
+ * 事件与定时器
+ ***********************************/
+
+static void bench_end_cb(void *cb_data, kevent_t *e)
+{
+    (void)cb_data;
+    (void)e;
+    bench_end = bench_cycles();
+}
+
+static void bench_nop_cb(void *cb_data, kevent_t *e)
+{
+    (void)cb_data;
+    (void)e;
+}
+
+static void bench_kevent(void)
+{
+    bench_stat_t stat;
+    kevent_t ev;
+    uint32_t i, start;
+
+    /* 立即事件在提交者的上下文中同步执行 */
+    kevent_init(&ev, bench_nop_cb, NULL, KEVENT_PRIORITY_IMMED);
+    bench_stat_begin(&stat, "kevent.post_immed", 0);
+    BENCH_RUN(&stat, kevent_post(&ev));
+    bench_stat_report(&stat);
+
+    /* 没有就绪事件时挂起抢占，抢占程序由快速路径直接返回 */
+    bench_stat_begin(&stat, "kevent.preempt_spurious", 0);
+    BENCH_RUN(&stat, (arch_irq_schedule_pending(), bench_dispatch()));
+    bench_stat_report(&stat);
+
+    /* 从提交到回调开始执行的延迟 */
+    kevent_init(&ev, bench_end_cb, NULL, KEVENT_PRIORITY_MIDDLE_GROUP);
+    bench_stat_begin(&stat, "kevent.post_dispatch", 0);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        kevent_post(&ev);
+        bench_dispatch();
+        bench_stat_add(&stat, bench_elapsed(start, bench_end), 1);
+    }
+    bench_stat_report(&stat);
+
+    /* 最高优先级组的延迟，KEVENT_IRQ_GROUP_NUMS不为0时由NVIC中断调度 */
+    kevent_init(&ev, bench_end_cb, NULL, KEVENT_PRIORITY_HIGHEST_GROUP);
+    bench_stat_begin(&stat, "kevent.post_dispatch_highest", KEVENT_IRQ_GROUP_NUMS);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        kevent_post(&ev);
+        bench_dispatch();
+        bench_stat_add(&stat, bench_elapsed(start, bench_end), 1);
+    }
+    bench_stat_report(&stat);
+}
+
+/* 中断处理程序的应答，模拟清除外设的中断标志 */
+static volatile uint32_t bench_irq_flags;
+
+static force_inline void bench_irq_ack(void)
+{
+    bench_irq_flags = 0;
+}
+
+static kevent_t bench_irq_ev = KEVENT_STATIC_INIT(bench_irq_ev, bench_end_cb, NULL, KEVENT_PRIORITY_IMMED);
+
+/* 手写的中断处理程序 */
+void bench_irq_hand_handler(void)
+{
+    bench_irq_ack();
+    kevent_post(&bench_irq_ev);
+}
+
+/* 由绑定表生成的中断处理程序 */
+#define BENCH_IRQ_TABLE(X)  \
+    X(bench_irq_stub_handler, bench_irq_ev, bench_irq_ack)
+
+KIRQ_TABLE_DEFINE(BENCH_IRQ_TABLE)
+
+static void bench_irq_post(const char *name, uint32_t irqn, uint8_t priority)
+{
+    bench_stat_t stat;
+    uint32_t i, start;
+
+    bench_irq_ev.priority = priority;
+
+    /* 从挂起中断到事件回调开始执行的延迟 */
+    bench_stat_begin(&stat, name, priority);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        bench_irq_raise(irqn);
+        bench_dispatch();
+        bench_stat_add(&stat, bench_elapsed(start, bench_end), 1);
+    }
+    bench_stat_report(&stat);
+}
+
+/* 最低优先级组由中断调度时没有抢占现场，不进行嵌套抢占测试 */
+#if KEVENT_IRQ_GROUP_NUMS < 4
+/* 嵌套抢占测试中挂起中断的时刻 */
+static uint32_t bench_unwind_start;
+
+/* 被抢占调度的低优先级事件，返回前挂起中断，中断在抢占程序恢复现场时进入 */
+static void bench_unwind_cb(void *cb_data, kevent_t *e)
+{
+    (void)cb_data;
+    (void)e;
+    bench_unwind_start = bench_cycles();
+    bench_irq_raise_on_return(BENCH_IRQN_HAND);
+}
+
+/* 在抢占现场的恢复期间由中断提交高优先级事件，测试嵌套抢占的延迟 */
+static void bench_preempt_unwind(void)
+{
+    bench_stat_t stat;
+    kevent_t ev;
+    uint32_t i;
+
+    bench_irq_ev.priority = KEVENT_PRIORITY_HIGH_GROUP;
+    kevent_init(&ev, bench_unwind_cb, NULL, KEVENT_PRIORITY_LOWER_GROUP);
+
+    /* 从挂起中断到高优先级事件的回调开始执行的延迟 */
+    bench_stat_begin(&stat, "kevent.preempt_unwind", 0);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        kevent_post(&ev);
+        bench_dispatch();
+        bench_stat_add(&stat, bench_elapsed(bench_unwind_start, bench_end), 1);
+    }
+    bench_stat_report(&stat);
+}
+#endif /* KEVENT_IRQ_GROUP_NUMS < 4 */
+
+/* 浮点现场的嵌套抢占，测量从线程触发中断到中断、事件与嵌套的中断全部返回的耗时 */
+static void bench_fp_preempt_run(bool fp_event)
+{
+    bench_stat_t stat;
+    uint32_t i, start;
+
+    if (!bench_fp_preempt(fp_event)) {
+        return;
+    }
+
+    bench_stat_begin(&stat, "kevent.preempt_fp", fp_event);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        bench_fp_preempt(fp_event);
+        bench_stat_add(&stat, bench_elapsed(start, bench_cycles()), 1);
+    }
+    bench_stat_report(&stat);
+}
+
+static void bench_ktimer(uint32_t n)
+{
+    bench_stat_t stat;
+    ktimer_event_t *probe = &bench_timers[n];
+    uint32_t i;
+
+    for (i = 0; i <= n; i++) {
+        ktimer_init(&bench_timers[i], bench_nop_cb, NULL, KEVENT_PRIORITY_LOWER_GROUP);
+    }
+
+    for (i = 0; i < n; i++) {
+        ktimer_start_expiry(&bench_timers[i], BENCH_TIMER_BASE + i * 16);
+    }
+
+    /* 插入到队列中间，需要遍历一半的定时器 */
+    bench_stat_begin(&stat, "ktimer.start_stop_mid", n);
+    BENCH_RUN(&stat, (ktimer_start_expiry(probe, BENCH_TIMER_BASE + n * 8 + 1),
+                      ktimer_stop(probe)));
+    bench_stat_report(&stat);
+
+    /* 插入到队列尾部 */
+    bench_stat_begin(&stat, "ktimer.start_stop_tail", n);
+    BENCH_RUN(&stat, (ktimer_start_expiry(probe, BENCH_TIMER_BASE + n * 16),
+                      ktimer_stop(probe)));
+    bench_stat_report(&stat);
+
+    for (i = 0; i < n; i++) {
+        ktimer_stop(&bench_timers[i]);
+    }
+}
+
+/***********************************
+ * 内存与消息
+ ***********************************/
+
+static void bench_kslab(void)
+{
+    bench_stat_t stat;
+
+    bench_stat_begin(&stat, "kslab.alloc_free", 0);
+    BENCH_RUN(&stat, kslab_mem_free(&bench_slab, kslab_mem_alloc(&bench_slab)));
+    bench_stat_report(&stat);
+}
+
+static void bench_listen_cb(void *cb_data, kevent_t *e)
+{
+    (void)cb_data;
+
+    if (kmsg_queue_pop(&bench_kmsg_q, e)) {
+        bench_end = bench_cycles();
+    }
+}
+
+static void bench_kmsg_round_trip(void)
+{
+    bench_stat_t stat;
+    uint32_t i, start;
+
+    kevent_init(&bench_listen_ev, bench_listen_cb, NULL, KEVENT_PRIORITY_MIDDLE_GROUP);
+    slist_node_init(&bench_msgs[0].node);
+
+    /* 从生产者入队到监听者取出消息的延迟 */
+    bench_stat_begin(&stat, "kmsg.round_trip", 0);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        kmsg_queue_pop(&bench_kmsg_q, &bench_listen_ev);
+
+        start = bench_cycles();
+        kmsg_queue_push(&bench_kmsg_q, &bench_msgs[0].node);
+        bench_dispatch();
+        bench_stat_add(&stat, bench_elapsed(start, bench_end), 1);
+    }
+    bench_stat_report(&stat);
+}
+
+/* 环形队列复制消息，与kslab分配消息再经由kmsg传递的对比 */
+static void bench_kring_vs_kmsg(void)
+{
+    bench_stat_t stat;
+    bench_msg_t msg = { {0}, {1, 2, 3} };
+    bench_msg_t out;
+    bench_msg_t *blk;
+
+    bench_stat_begin(&stat, "kring.push_pop", sizeof(bench_msg_t));
+    BENCH_RUN(&stat, (kring_queue_push(&bench_ring, &msg),
+                      kring_queue_pop(&bench_ring, &out, NULL)));
+    bench_stat_report(&stat);
+
+    bench_stat_begin(&stat, "kmsg_kslab.push_pop", sizeof(bench_msg_t));
+    BENCH_RUN(&stat, (blk = (bench_msg_t *)kslab_mem_alloc(&bench_slab),
+                      slist_node_init(&blk->node),
+                      blk->data[0] = msg.data[0],
+                      kmsg_queue_push(&bench_kmsg_q, &blk->node),
+                      kslab_mem_free(&bench_slab, kmsg_queue_pop(&bench_kmsg_q, NULL))));
+    bench_stat_report(&stat);
+}
+
+/* 中断中的生产者积累了多条消息后，消费者逐条取出与一次取出全部消息的对比 */
+static void bench_kmsg_drain(void)
+{
+    bench_stat_t stat;
+    fifo_t out;
+    uint32_t i, j, start;
+
+    bench_stat_begin(&stat, "kmsg.drain_pop", BENCH_DRAIN_NUMS);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        for (j = 0; j < BENCH_DRAIN_NUMS; j++) {
+            slist_node_init(&bench_msgs[j].node);
+            kmsg_queue_push(&bench_kmsg_q, &bench_msgs[j].node);
+        }
+
+        start = bench_cycles();
+        while (kmsg_queue_pop(&bench_kmsg_q, NULL));
+        bench_stat_add(&stat, bench_elapsed(start, bench_cycles()), BENCH_DRAIN_NUMS);
+    }
+    bench_stat_report(&stat);
+
+    bench_stat_begin(&stat, "kmsg.drain_pop_all", BENCH_DRAIN_NUMS);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        for (j = 0; j < BENCH_DRAIN_NUMS; j++) {
+            slist_node_init(&bench_msgs[j].node);
+            kmsg_queue_push(&bench_kmsg_q, &bench_msgs[j].node);
+        }
+
+        start = bench_cycles();
+        fifo_init(&out);
+        kmsg_queue_pop_all(&bench_kmsg_q, &out, NULL);
+        while (!fifo_is_empty(&out)) {
+            fifo_pop(&out);
+        }
+        bench_stat_add(&stat, bench_elapsed(start, bench_cycles()), BENCH_DRAIN_NUMS);
+    }
+    bench_stat_report(&stat);
+}
+
+/***********************************
+ * 协程
+ ***********************************/
+
+static void bench_co_leaf(ktask_co_t *task, kevent_t *ev, int arg)
+{
+    (void)ev;
+    (void)arg;
+
+    ktask_co_asyn_return(task);
+}
+
+static void bench_co_top(ktask_co_t *task, kevent_t *ev)
+{
+    uint8_t *bpd = KTASK_CO_BPD(task);
+
+    (void)ev;
+
+    bpd_begin(1);
+
+    for (bench_co_calls = 0; bench_co_calls < BENCH_BATCH; bench_co_calls++) {
+        ktask_co_bpd_asyn_call(1, task, bench_co_leaf, 0);
+    }
+
+    ktask_co_asyn_return(task);
+    bpd_end();
+}
+
+static void bench_ktask_co(void)
+{
+    bench_stat_t stat;
+    uint32_t i, start;
+
+    /* 每次启动任务执行BENCH_BATCH次同步完成的异步调用与返回 */
+    bench_stat_begin(&stat, "ktask_co.call_return", 0);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = bench_cycles();
+        task_start(&bench_task, bench_co_top);
+        bench_stat_add(&stat, bench_elapsed(start, bench_cycles()), BENCH_BATCH);
+    }
+    bench_stat_report(&stat);
+
+    /* 分段异步栈的任务不分配任何段直接返回，任务结束时没有可归还的段 */
+    bench_stat_begin(&stat, "ktask_co.seg_start_return", 0);
+    BENCH_RUN(&stat, task_start(&bench_seg_task, bench_co_leaf, 0));
+    bench_stat_report(&stat);
+}
+
+/* bp协程从第n个断点恢复执行的开销，n为协程中的断点个数 */
+#define BENCH_BP_YIELD2(a, b)   bpd_yield(a); bpd_yield(b);
+#define BENCH_BP_YIELD8(a, b, c, d, e, f, g, h)                                 \
+    bpd_yield(a); bpd_yield(b); bpd_yield(c); bpd_yield(d);                     \
+    bpd_yield(e); bpd_yield(f); bpd_yield(g); bpd_yield(h);
+
+static void bench_bp_resume_2(uint8_t *bpd)
+{
+    bpd_begin(2);
+
+    while (1) {
+        BENCH_BP_YIELD2(1, 2)
+    }
+
+    bpd_end();
+}
+
+static void bench_bp_resume_8(uint8_t *bpd)
+{
+    bpd_begin(8);
+
+    while (1) {
+        BENCH_BP_YIELD8(1, 2, 3, 4, 5, 6, 7, 8)
+    }
+
+    bpd_end();
+}
+
+static void bench_bp_resume_32(uint8_t *bpd)
+{
+    bpd_begin(32);
+
+    while (1) {
+        BENCH_BP_YIELD8(1, 2, 3, 4, 5, 6, 7, 8)
+        BENCH_BP_YIELD8(9, 10, 11, 12, 13, 14, 15, 16)
+        BENCH_BP_YIELD8(17, 18, 19, 20, 21, 22, 23, 24)
+        BENCH_BP_YIELD8(25, 26, 27, 28, 29, 30, 31, 32)
+    }
+
+    bpd_end();
+}
+
+static void bench_bp_resume_128(uint8_t *bpd)
+{
+    bpd_begin(128);
+
+    while (1) {
+        BENCH_BP_YIELD8(1, 2, 3, 4, 5, 6, 7, 8)
+        BENCH_BP_YIELD8(9, 10, 11, 12, 13, 14, 15, 16)
+        BENCH_BP_YIELD8(17, 18, 19, 20, 21, 22, 23, 24)
+        BENCH_BP_YIELD8(25, 26, 27, 28, 29, 30, 31, 32)
+        BENCH_BP_YIELD8(33, 34, 35, 36, 37, 38, 39, 40)
+        BENCH_BP_YIELD8(41, 42, 43, 44, 45, 46, 47, 48)
+        BENCH_BP_YIELD8(49, 50, 51, 52, 53, 54, 55, 56)
+        BENCH_BP_YIELD8(57, 58, 59, 60, 61, 62, 63, 64)
+        BENCH_BP_YIELD8(65, 66, 67, 68, 69, 70, 71, 72)
+        BENCH_BP_YIELD8(73, 74, 75, 76, 77, 78, 79, 80)
+        BENCH_BP_YIELD8(81, 82, 83, 84, 85, 86, 87, 88)
+        BENCH_BP_YIELD8(89, 90, 91, 92, 93, 94, 95, 96)
+        BENCH_BP_YIELD8(97, 98, 99, 100, 101, 102, 103, 104)
+        BENCH_BP_YIELD8(105, 106, 107, 108, 109, 110, 111, 112)
+        BENCH_BP_YIELD8(113, 114, 115, 116, 117, 118, 119, 120)
+        BENCH_BP_YIELD8(121, 122, 123, 124, 125, 126, 127, 128)
+    }
+
+    bpd_end();
+}
+
+static void bench_bp_resume(const char *name, uint32_t n, void (*func)(uint8_t *bpd))
+{
+    bench_stat_t stat;
+    uint8_t bp = BP_INIT_VAL;
+
+    bench_stat_begin(&stat, name, n);
+    BENCH_RUN(&stat, func(&bp));
+    bench_stat_report(&stat);
+}
+
+void bench_cases_run(void)
+{
+    static const uint32_t lens[] = { 1, 8, 64 };
+    static const uint32_t timers[] = { 0, 8, 32, 128 };
+    uint32_t i;
+
+    for (i = 0; i < ARRAY_SIZE(lens); i++) {
+        bench_slist(lens[i]);
+        bench_fifo(lens[i]);
+        bench_lifo(lens[i]);
+        bench_dlist(lens[i]);
+        bench_pheap(lens[i]);
+    }
+
+    bench_kevent();
+
+    bench_irq_post("kirq.hand_post", BENCH_IRQN_HAND, KEVENT_PRIORITY_IMMED);
+    bench_irq_post("kirq.stub_post", BENCH_IRQN_STUB, KEVENT_PRIORITY_IMMED);
+    bench_irq_post("kirq.hand_post", BENCH_IRQN_HAND, KEVENT_PRIORITY_HIGH_GROUP);
+    bench_irq_post("kirq.stub_post", BENCH_IRQN_STUB, KEVENT_PRIORITY_HIGH_GROUP);
+
+#if KEVENT_IRQ_GROUP_NUMS < 4
+    bench_preempt_unwind();
+#endif
+
+    bench_fp_preempt_run(false);
+    bench_fp_preempt_run(true);
+
+    for (i = 0; i < ARRAY_SIZE(timers); i++) {
+        bench_ktimer(timers[i]);
+    }
+
+    bench_kslab();
+    bench_kmsg_round_trip();
+    bench_kring_vs_kmsg();
+    bench_kmsg_drain();
+    bench_ktask_co();
+
+    bench_bp_resume("bp.resume", 2, bench_bp_resume_2);
+    bench_bp_resume("bp.resume", 8, bench_bp_resume_8);
+    bench_bp_resume("bp.resume", 32, bench_bp_resume_32);
+    bench_bp_resume("bp.resume", 128, bench_bp_resume_128);
+}
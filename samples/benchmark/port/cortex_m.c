@@ -0,0 +1,503 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <drivers/regs_util.h>
+#include <drivers/timer_port.h>
+#include "../bench.h"
+
+/*********************************************************
+ * QEMU mps2-an385(Cortex-M3)与mps2-an505(Cortex-M33)的最小运行环境：
+ * 向量表与启动代码、周期计数器、semihosting输出与退出
+ *
+ * DWT CYCCNT可用时使用它计数，否则(如QEMU)使用以处理器时钟
+ * 向下计数的SysTick，由软件扩展为32位
+ *
+ * ARMv8-M Mainline上使用MSPLIM限制主栈，栈溢出时产生精确的UsageFault
+ *
+ * 以硬件浮点编译时(mps2-an386)使用preempt_fp.s，并进行浮点现场的嵌套抢占测试
+ *********************************************************/
+
+#if defined(__ARM_ARCH_8M_MAIN__)
+const char *const bench_target = "cortex-m33";
+#elif defined(__ARM_FP)
+const char *const bench_target = "cortex-m4f";
+#else
+const char *const bench_target = "cortex-m3";
+#endif
+const char *const bench_unit = "cycles";
+
+/* DWT与调试寄存器 */
+#define DWT_BASE                    0xE0001000
+#define DWT_F_CYCCNTENA             REG_FIELD(0x0000, 0, 0)
+#define DWT_R_CYCCNT                REG_ENTITY(0x0004)
+
+#define CORE_DEBUG_BASE             0xE000EDF0
+#define CORE_DEBUG_F_TRCENA         REG_FIELD(0x000C, 24, 24)
+
+/* SysTick寄存器 */
+#define SYSTICK_BASE                0xE000E010
+#define SYSTICK_F_CLKSOURCE         REG_FIELD(0x0000, 2, 2)
+#define SYSTICK_F_ENABLE            REG_FIELD(0x0000, 0, 0)
+#define SYSTICK_R_RELOAD            REG_ENTITY(0x0004)
+#define SYSTICK_R_CVR               REG_ENTITY(0x0008)
+#define SYSTICK_COUNT_MASK          (BIT(24) - 1)
+
+/* PendSV优先级位于SHPR3的[23:16] */
+#define SCB_BASE                    0xE000ED00
+#define SCB_F_PRI_PENDSV            REG_FIELD(0x0020, 16, 23)
+
+/* CP10与CP11(浮点单元)的访问权限 */
+#define SCB_F_CPACR_CP10_CP11       REG_FIELD(0x0088, 20, 23)
+
+/* UsageFault使能与可配置错误状态寄存器 */
+#define SCB_F_USGFAULTENA           REG_FIELD(0x0024, 18, 18)
+#define SCB_R_CFSR                  REG_ENTITY(0x0028)
+
+/* NVIC中断使能、挂起与中断优先级寄存器 */
+#define NVIC_ISER                   ((volatile uint32_t *)0xE000E100)
+#define NVIC_ISPR                   ((volatile uint32_t *)0xE000E200)
+#define NVIC_IPR                    ((volatile uint8_t *)0xE000E400)
+
+/* mps2-an385的外部中断个数 */
+#define BENCH_IRQ_NUMS              32
+
+/* 浮点抢占测试中由线程触发、提交事件的中断与在事件中触发的嵌套中断 */
+#define BENCH_IRQN_FP_POST          26
+#define BENCH_IRQN_FP_NESTED        27
+
+/* semihosting操作 */
+#define SEMIHOSTING_SYS_WRITE0      0x04
+#define SEMIHOSTING_SYS_EXIT        0x18
+#define SEMIHOSTING_APP_EXIT        0x20026
+
+/* 为1时在输出结果后递归耗尽主栈，ARMv8-M Mainline上由MSPLIM产生STKOF，
+ * bench_fault_handler输出CFSR=0x00100000后结束运行 */
+#ifndef BENCH_STKOF_TEST
+#define BENCH_STKOF_TEST            0
+#endif
+
+/* 主栈的最低地址，由链接脚本定义 */
+extern uint32_t __stack_limit;
+
+/* 是否使用DWT CYCCNT */
+static bool bench_use_dwt;
+
+/* SysTick扩展为32位计数的高位与上一次的读数 */
+static uint32_t bench_systick_high;
+static uint32_t bench_systick_last;
+
+static void bench_irq_init(uint32_t irqn, uint8_t priority)
+{
+    NVIC_IPR[irqn] = priority;
+    NVIC_ISER[irqn >> 5] = BIT(irqn & 0x1F);
+}
+
+#if KEVENT_IRQ_GROUP_NUMS
+/* 由中断调度的事件组，优先级高于PendSV，组越高优先级越高 */
+static void bench_irq_group_init(uint8_t ready_group)
+{
+    bench_irq_init(KEVENT_IRQ_GROUP_IRQN(ready_group),
+                   0x60 + (KEVENT_PRIORITY_GROUP_COUNT - 1 - ready_group) * 0x20);
+}
+#endif /* KEVENT_IRQ_GROUP_NUMS */
+
+#if defined(__ARM_FP)
+/* 线程、事件与嵌套中断各自写入浮点寄存器的值 */
+static uint32_t bench_fp_patterns[3][32];
+
+static kevent_t bench_fp_ev;
+static bool bench_fp_event_uses_fp;
+
+/* 被破坏的浮点寄存器个数 */
+static int bench_fp_errors;
+
+/* 以pattern设置S0-S31后挂起中断，中断返回后统计S0-S31中与pattern不同的个数 */
+static int bench_fp_regs_check(const uint32_t *pattern, uint32_t irqn)
+{
+    uint32_t regs[32];
+    int i, errors = 0;
+
+    __asm volatile (
+        "vldm %[pattern], {s0-s31}\n"
+        "str %[bit], [%[ispr]]\n"
+        "dsb\n"
+        "isb\n"
+        "vstm %[regs], {s0-s31}\n"
+        :
+        : [pattern] "r" (pattern), [regs] "r" (regs),
+          [bit] "r" (BIT(irqn & 0x1F)), [ispr] "r" (&NVIC_ISPR[irqn >> 5])
+        : "memory",
+          "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+          "s8", "s9", "s10", "s11", "s12", "s13", "s14", "s15",
+          "s16", "s17", "s18", "s19", "s20", "s21", "s22", "s23",
+          "s24", "s25", "s26", "s27", "s28", "s29", "s30", "s31");
+
+    for (i = 0; i < 32; i++) {
+        if (regs[i] != pattern[i]) {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/* 以pattern覆盖S0-S31，首条浮点指令触发被中断现场的Lazy Stacking */
+static void bench_fp_regs_clobber(const uint32_t *pattern)
+{
+    __asm volatile (
+        "vldm %[pattern], {s0-s31}\n"
+        :
+        : [pattern] "r" (pattern)
+        : "memory",
+          "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+          "s8", "s9", "s10", "s11", "s12", "s13", "s14", "s15",
+          "s16", "s17", "s18", "s19", "s20", "s21", "s22", "s23",
+          "s24", "s25", "s26", "s27", "s28", "s29", "s30", "s31");
+}
+
+/* 由抢占程序调度的事件，在不使用浮点的事件中由嵌套的中断使用浮点，或者相反 */
+static void bench_fp_event_cb(void *cb_data, kevent_t *e)
+{
+    (void)cb_data;
+    (void)e;
+
+    if (bench_fp_event_uses_fp) {
+        bench_fp_errors += bench_fp_regs_check(bench_fp_patterns[1], BENCH_IRQN_FP_NESTED);
+    } else {
+        bench_irq_raise(BENCH_IRQN_FP_NESTED);
+    }
+}
+
+static void bench_fp_post_handler(void)
+{
+    kevent_post(&bench_fp_ev);
+}
+
+static void bench_fp_nested_handler(void)
+{
+    if (!bench_fp_event_uses_fp) {
+        bench_fp_regs_clobber(bench_fp_patterns[2]);
+    }
+}
+
+static void bench_fp_init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 32; i++) {
+        bench_fp_patterns[0][i] = 0x3F800000 + i;
+        bench_fp_patterns[1][i] = 0x40000000 + i;
+        bench_fp_patterns[2][i] = 0xC0000000 + i;
+    }
+
+    kevent_init(&bench_fp_ev, bench_fp_event_cb, NULL, KEVENT_PRIORITY_LOWER_GROUP);
+
+    /* 嵌套的中断优先级更高，事件由中断调度时也能嵌套 */
+    bench_irq_init(BENCH_IRQN_FP_POST, 0x40);
+    bench_irq_init(BENCH_IRQN_FP_NESTED, 0x20);
+}
+
+bool bench_fp_preempt(bool fp_event)
+{
+    bench_fp_event_uses_fp = fp_event;
+    bench_fp_errors = bench_fp_regs_check(bench_fp_patterns[0], BENCH_IRQN_FP_POST);
+
+    if (bench_fp_errors) {
+        printf("\nfp: %d registers corrupted, fp_event=%d\n", bench_fp_errors, fp_event);
+        bench_exit(1);
+    }
+
+    return true;
+}
+#else
+bool bench_fp_preempt(bool fp_event)
+{
+    (void)fp_event;
+    return false;
+}
+#endif /* __ARM_FP */
+
+void bench_port_init(void)
+{
+    uint32_t start;
+
+    /* PendSV设置为最低优先级 */
+    REG_WRITE_FIELD(SCB_BASE, SCB_F_PRI_PENDSV, 0xFF);
+
+    /* 使能UsageFault，栈溢出等错误不再升级为HardFault */
+    REG_WRITE_FIELD(SCB_BASE, SCB_F_USGFAULTENA, 1);
+
+#if defined(__ARM_ARCH_8M_MAIN__)
+    arch_stack_limit_set((uint32_t)&__stack_limit, 0);
+#endif
+
+    bench_irq_init(BENCH_IRQN_HAND, 0x40);
+    bench_irq_init(BENCH_IRQN_STUB, 0x40);
+
+#if defined(__ARM_FP)
+    bench_fp_init();
+#endif
+
+#if KEVENT_IRQ_GROUP_NUMS
+    for (start = KEVENT_IRQ_GROUP_FIRST; start < KEVENT_PRIORITY_GROUP_COUNT; start++) {
+        bench_irq_group_init(start);
+    }
+#endif /* KEVENT_IRQ_GROUP_NUMS */
+
+    REG_WRITE_FIELD(CORE_DEBUG_BASE, CORE_DEBUG_F_TRCENA, 1);
+    REG_WRITE_FIELD(DWT_BASE, DWT_R_CYCCNT, 0);
+    REG_WRITE_FIELD(DWT_BASE, DWT_F_CYCCNTENA, 1);
+
+    start = REG_READ_FIELD(DWT_BASE, DWT_R_CYCCNT);
+    __asm volatile ("nop\n nop\n nop\n nop");
+    bench_use_dwt = REG_READ_FIELD(DWT_BASE, DWT_R_CYCCNT) != start;
+
+    if (!bench_use_dwt) {
+        REG_WRITE_FIELD(SYSTICK_BASE, SYSTICK_R_RELOAD, SYSTICK_COUNT_MASK);
+        REG_WRITE_FIELD(SYSTICK_BASE, SYSTICK_R_CVR, 0);
+        REG_WRITE_FIELDS_NO_READBACK(SYSTICK_BASE,
+                                     SYSTICK_F_CLKSOURCE, 1,
+                                     SYSTICK_F_ENABLE, 1);
+    }
+}
+
+uint32_t bench_cycles(void)
+{
+    uint32_t now;
+
+    if (bench_use_dwt) {
+        return REG_READ_FIELD(DWT_BASE, DWT_R_CYCCNT);
+    }
+
+    /* 两次读取之间不超过2^24个周期，读数回绕即为一次溢出 */
+    now = SYSTICK_COUNT_MASK - REG_READ_FIELD(SYSTICK_BASE, SYSTICK_R_CVR);
+    if (now < bench_systick_last) {
+        bench_systick_high += BIT(24);
+    }
+    bench_systick_last = now;
+
+    return bench_systick_high + now;
+}
+
+/* 挂起中断后，中断在下一条指令之前进入 */
+void bench_irq_raise(uint32_t irqn)
+{
+    NVIC_ISPR[irqn >> 5] = BIT(irqn & 0x1F);
+    __asm volatile ("dsb\n isb" ::: "memory");
+}
+
+/* 中断保持挂起，直到PendSV恢复被抢占的上下文后执行CPSIE I，在现场恢复的末尾进入 */
+void bench_irq_raise_on_return(uint32_t irqn)
+{
+    (void)arch_irq_lock();
+
+    NVIC_ISPR[irqn >> 5] = BIT(irqn & 0x1F);
+    __asm volatile ("dsb" ::: "memory");
+}
+
+/* PendSV在提交事件的irq_unlock之后立即抢占，事件已经执行完毕 */
+void bench_dispatch(void)
+{
+}
+
+static int semihosting_call(int op, void *arg)
+{
+    register int r0 __asm("r0") = op;
+    register void *r1 __asm("r1") = arg;
+
+    __asm volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+
+    return r0;
+}
+
+#if BENCH_STKOF_TEST
+/* 每层占用至少64字节的栈，直到触发栈溢出错误 */
+static __attribute__((noinline)) uint32_t bench_stack_overflow(uint32_t depth)
+{
+    volatile uint32_t buf[16];
+
+    buf[0] = depth;
+    if (depth == UINT32_MAX) {
+        return buf[0];
+    }
+
+    return bench_stack_overflow(depth + 1) + buf[0];
+}
+#endif /* BENCH_STKOF_TEST */
+
+void bench_exit(int code)
+{
+    fflush(stdout);
+
+#if BENCH_STKOF_TEST
+    if (code == 0) {
+        bench_stack_overflow(0);
+    }
+#else
+    (void)code;
+#endif /* BENCH_STKOF_TEST */
+    semihosting_call(SEMIHOSTING_SYS_EXIT, (void *)SEMIHOSTING_APP_EXIT);
+
+    while (1);
+}
+
+/* newlib的输出接口，按块复制为以'\0'结尾的字符串后输出 */
+int _write(int fd, const char *buf, int len)
+{
+    char chunk[64];
+    int n, remain = len;
+
+    (void)fd;
+
+    while (remain > 0) {
+        n = remain < (int)sizeof(chunk) - 1 ? remain : (int)sizeof(chunk) - 1;
+        memcpy(chunk, buf, n);
+        chunk[n] = '\0';
+        semihosting_call(SEMIHOSTING_SYS_WRITE0, chunk);
+
+        buf += n;
+        remain -= n;
+    }
+
+    return len;
+}
+
+/***********************************
+ * 定时器驱动，测试中的定时器不会到期
+ ***********************************/
+
+ktime_tick_t drv_ktime_tick_get(void)
+{
+    return 0;
+}
+
+ktime_ms_t drv_ktime_tick_to_ms(ktime_tick_t tick)
+{
+    return tick / 1000;
+}
+
+ktime_us_t drv_ktime_tick_to_us(ktime_tick_t tick)
+{
+    return tick;
+}
+
+ktime_tick_t drv_ktime_us_to_tick(ktime_us_t us)
+{
+    return us;
+}
+
+ktime_tick_t drv_ktime_ms_to_tick(ktime_ms_t ms)
+{
+    return ms * 1000;
+}
+
+void drv_ktimer_set_expiry(ktime_tick_t expiry)
+{
+    (void)expiry;
+}
+
+/***********************************
+ * 向量表与启动代码
+ ***********************************/
+
+extern uint32_t __stack_top;
+extern uint32_t __data_load, __data_start, __data_end;
+extern uint32_t __bss_start, __bss_end;
+
+extern int main(void);
+extern void PendSV_Handler(void);
+
+void Reset_Handler(void)
+{
+    uint32_t *src = &__data_load;
+    uint32_t *dst;
+
+#if defined(__ARM_FP)
+    /* 在任何浮点指令之前使能浮点单元，FPCCR默认开启Lazy Stacking */
+    REG_WRITE_FIELD(SCB_BASE, SCB_F_CPACR_CP10_CP11, 0xF);
+    __asm volatile ("dsb\n isb" ::: "memory");
+#endif
+
+    for (dst = &__data_start; dst < &__data_end; dst++) {
+        *dst = *src++;
+    }
+
+    for (dst = &__bss_start; dst < &__bss_end; dst++) {
+        *dst = 0;
+    }
+
+    bench_exit(main());
+}
+
+void Default_Handler(void)
+{
+    while (1);
+}
+
+/* 输出错误状态后结束运行，CFSR的BIT20(STKOF)表示栈溢出 */
+__attribute__((used)) void bench_fault_report(void)
+{
+    printf("\nfault: CFSR=0x%08lx\n", (unsigned long)REG_READ_FIELD(SCB_BASE, SCB_R_CFSR));
+    bench_exit(1);
+}
+
+/* 栈溢出时SP位于栈限制处，先解除栈限制，错误报告才能使用栈 */
+__attribute__((naked)) void bench_fault_handler(void)
+{
+    __asm volatile (
+#if defined(__ARM_ARCH_8M_MAIN__)
+        "movs r0, #0\n"
+        "msr msplim, r0\n"
+#endif
+        "b bench_fault_report\n");
+}
+
+#if KEVENT_IRQ_GROUP_NUMS >= 1
+KEVENT_IRQ_GROUP_HANDLER_DEFINE(bench_irq_group3_handler, KEVENT_PRIORITY_HIGHEST_GROUP)
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 2
+KEVENT_IRQ_GROUP_HANDLER_DEFINE(bench_irq_group2_handler, KEVENT_PRIORITY_HIGH_GROUP)
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 3
+KEVENT_IRQ_GROUP_HANDLER_DEFINE(bench_irq_group1_handler, KEVENT_PRIORITY_MIDDLE_GROUP)
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 4
+KEVENT_IRQ_GROUP_HANDLER_DEFINE(bench_irq_group0_handler, KEVENT_PRIORITY_LOWER_GROUP)
+#endif
+
+__attribute__((used, section(".vectors")))
+static void (*const bench_vectors[16 + BENCH_IRQ_NUMS])(void) = {
+    [0] = (void (*)(void))&__stack_top,
+    [1] = Reset_Handler,
+    [2] = Default_Handler,      /* NMI */
+    [3] = bench_fault_handler,  /* HardFault */
+    [4] = bench_fault_handler,  /* MemManage */
+    [5] = bench_fault_handler,  /* BusFault */
+    [6] = bench_fault_handler,  /* UsageFault */
+    [7] = bench_fault_handler,  /* SecureFault */
+    [11] = Default_Handler,     /* SVCall */
+    [12] = Default_Handler,     /* DebugMon */
+    [14] = PendSV_Handler,
+    [15] = Default_Handler,     /* SysTick */
+    [16 + BENCH_IRQN_HAND] = bench_irq_hand_handler,
+    [16 + BENCH_IRQN_STUB] = bench_irq_stub_handler,
+#if defined(__ARM_FP)
+    [16 + BENCH_IRQN_FP_POST] = bench_fp_post_handler,
+    [16 + BENCH_IRQN_FP_NESTED] = bench_fp_nested_handler,
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 1
+    [16 + KEVENT_IRQ_GROUP_IRQN(3)] = bench_irq_group3_handler,
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 2
+    [16 + KEVENT_IRQ_GROUP_IRQN(2)] = bench_irq_group2_handler,
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 3
+    [16 + KEVENT_IRQ_GROUP_IRQN(1)] = bench_irq_group1_handler,
+#endif
+#if KEVENT_IRQ_GROUP_NUMS >= 4
+    [16 + KEVENT_IRQ_GROUP_IRQN(0)] = bench_irq_group0_handler,
+#endif
+};
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <drivers/timer_port.h>
+#include "../bench.h"
+
+/* 主机上没有周期计数器，使用单调时钟的纳秒数 */
+const char *const bench_target = "host";
+const char *const bench_unit = "ns";
+
+void bench_port_init(void)
+{
+}
+
+uint32_t bench_cycles(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+/* bench_irq_raise_on_return挂起的中断 */
+static bool bench_irq_deferred;
+static uint32_t bench_irq_deferred_irqn;
+
+/* 主机上没有PendSV，由提交者直接运行调度程序，调度结束后进入挂起的中断 */
+void bench_dispatch(void)
+{
+    kevent_schedule();
+
+    while (bench_irq_deferred) {
+        bench_irq_deferred = false;
+        bench_irq_raise(bench_irq_deferred_irqn);
+        kevent_schedule();
+    }
+}
+
+/* 主机上没有可以由抢占程序管理的浮点现场 */
+bool bench_fp_preempt(bool fp_event)
+{
+    (void)fp_event;
+    return false;
+}
+
+void bench_exit(int code)
+{
+    exit(code);
+}
+
+/* 主机上没有中断，直接调用向量对应的处理程序 */
+void bench_irq_raise(uint32_t irqn)
+{
+    switch (irqn) {
+    case BENCH_IRQN_HAND:
+        bench_irq_hand_handler();
+        break;
+
+    case BENCH_IRQN_STUB:
+        bench_irq_stub_handler();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* 主机上没有抢占程序，中断在调度程序返回后由bench_dispatch进入 */
+void bench_irq_raise_on_return(uint32_t irqn)
+{
+    bench_irq_deferred = true;
+    bench_irq_deferred_irqn = irqn;
+}
+
+/***********************************
+ * 定时器驱动，测试中的定时器不会到期
+ ***********************************/
+
+ktime_tick_t drv_ktime_tick_get(void)
+{
+    return 0;
+}
+
+ktime_ms_t drv_ktime_tick_to_ms(ktime_tick_t tick)
+{
+    return tick / 1000;
+}
+
+ktime_us_t drv_ktime_tick_to_us(ktime_tick_t tick)
+{
+    return tick;
+}
+
+ktime_tick_t drv_ktime_us_to_tick(ktime_us_t us)
+{
+    return us;
+}
+
+ktime_tick_t drv_ktime_ms_to_tick(ktime_ms_t ms)
+{
+    return ms * 1000;
+}
+
+void drv_ktimer_set_expiry(ktime_tick_t expiry)
+{
+    (void)expiry;
+}
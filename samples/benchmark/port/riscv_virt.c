@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2021 xiaoliang<1296283984@qq.com>.
+ */
+
+#include <stdio.h>
+#include <drivers/timer_port.h>
+#include <drivers/riscv/clint_timer.h>
+#include "../bench.h"
+
+/*********************************************************
+ * QEMU virt(RV32)的最小运行环境：启动代码、周期计数器、
+ * NS16550 UART输出与sifive_test设备退出
+ *
+ * 抢占通过CLINT的机器软件中断完成，定时器使用drivers/timer/riscv_clint_timer.c
+ *********************************************************/
+
+#if KEVENT_IRQ_GROUP_NUMS
+#error "RISC-V CLINT cannot pend external interrupts, KEVENT_IRQ_GROUP_NUMS must be 0"
+#endif
+
+const char *const bench_target = "riscv32-virt";
+const char *const bench_unit = "cycles";
+
+/* QEMU virt的外设地址 */
+#define VIRT_TEST_BASE              0x00100000
+#define VIRT_UART0_BASE             0x10000000
+
+/* sifive_test设备的结束码 */
+#define VIRT_TEST_PASS              0x5555
+#define VIRT_TEST_FAIL              0x3333
+
+/* NS16550的发送保持寄存器与线路状态寄存器 */
+#define UART_THR                    ((volatile uint8_t *)(VIRT_UART0_BASE + 0))
+#define UART_LSR                    ((volatile uint8_t *)(VIRT_UART0_BASE + 5))
+#define UART_LSR_THRE               BIT(5)
+
+/* mtime的计数频率，用于滴答与时间单位的转换 */
+#define VIRT_MTIME_FREQ_MHZ         10
+
+/* mie.MSIE */
+#define RISCV_MIE_MSIE              BIT(3)
+
+extern void riscv_trap_entry(void);
+
+void bench_port_init(void)
+{
+    __asm volatile("csrw mtvec, %0" : : "r" (riscv_trap_entry) : "memory");
+
+    riscv_clint_timer_init();
+
+    /* 使能机器软件中断并打开中断 */
+    __asm volatile("csrs mie, %0;"
+        "csrs mstatus, %1"
+        :
+        : "r" (RISCV_MIE_MSIE), "r" (RISCV_MSTATUS_MIE)
+        : "memory");
+}
+
+uint32_t bench_cycles(void)
+{
+    uint32_t cycles;
+
+    __asm volatile("csrr %0, mcycle" : "=r" (cycles));
+
+    return cycles;
+}
+
+/* 机器软件中断在提交事件的irq_unlock之后立即抢占，事件已经执行完毕 */
+void bench_dispatch(void)
+{
+}
+
+static void bench_irq_handler_call(uint32_t irqn)
+{
+    switch (irqn) {
+    case BENCH_IRQN_HAND:
+        bench_irq_hand_handler();
+        break;
+
+    case BENCH_IRQN_STUB:
+        bench_irq_stub_handler();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* CLINT上没有可由软件挂起的外部中断，在关闭中断的状态下直接调用处理程序以模拟中断上下文 */
+void bench_irq_raise(uint32_t irqn)
+{
+    int key = irq_lock();
+
+    bench_irq_handler_call(irqn);
+
+    irq_unlock(key);
+}
+
+/* 处理程序在关闭中断的状态下提交事件，挂起的软件中断在陷阱入口mret重新打开中断之后进入 */
+void bench_irq_raise_on_return(uint32_t irqn)
+{
+    (void)arch_irq_lock();
+
+    bench_irq_handler_call(irqn);
+}
+
+/* RV32IMAC上没有可以由抢占程序管理的浮点现场 */
+bool bench_fp_preempt(bool fp_event)
+{
+    (void)fp_event;
+    return false;
+}
+
+void bench_exit(int code)
+{
+    fflush(stdout);
+
+    *(volatile uint32_t *)VIRT_TEST_BASE = code ? ((uint32_t)code << 16) | VIRT_TEST_FAIL
+                                                : VIRT_TEST_PASS;
+
+    while (1);
+}
+
+/* newlib的输出接口 */
+int _write(int fd, const char *buf, int len)
+{
+    int i;
+
+    (void)fd;
+
+    for (i = 0; i < len; i++) {
+        while (!(*UART_LSR & UART_LSR_THRE));
+        *UART_THR = buf[i];
+    }
+
+    return len;
+}
+
+/***********************************
+ * 滴答与时间单位的转换，滴答即mtime的计数
+ ***********************************/
+
+ktime_ms_t drv_ktime_tick_to_ms(ktime_tick_t tick)
+{
+    return tick / (VIRT_MTIME_FREQ_MHZ * 1000);
+}
+
+ktime_us_t drv_ktime_tick_to_us(ktime_tick_t tick)
+{
+    return tick / VIRT_MTIME_FREQ_MHZ;
+}
+
+ktime_tick_t drv_ktime_us_to_tick(ktime_us_t us)
+{
+    return us * VIRT_MTIME_FREQ_MHZ;
+}
+
+ktime_tick_t drv_ktime_ms_to_tick(ktime_ms_t ms)
+{
+    return ms * (VIRT_MTIME_FREQ_MHZ * 1000);
+}
+
+/***********************************
+ * 启动代码，由QEMU -bios none直接从0x80000000进入
+ ***********************************/
+
+extern uint32_t __bss_start, __bss_end;
+
+extern int main(void);
+
+void bench_c_start(void)
+{
+    uint32_t *dst;
+
+    for (dst = &__bss_start; dst < &__bss_end; dst++) {
+        *dst = 0;
+    }
+
+    bench_exit(main());
+}
+
+/* 设置全局指针与栈后进入C代码，陷阱入口在bench_port_init中设置 */
+__attribute__((naked, section(".text.init"))) void _start(void)
+{
+    __asm volatile (
+        ".option push\n"
+        ".option norelax\n"
+        "la gp, __global_pointer$\n"
+        ".option pop\n"
+        "la sp, __stack_top\n"
+        "j bench_c_start\n");
+}